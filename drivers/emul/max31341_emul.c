@@ -0,0 +1,298 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT adi_max31341
+
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#if CONFIG_GPIO_EMUL
+    #include <zephyr/drivers/gpio/gpio_emul.h>
+#endif
+
+#include "emul/max31341_emul.h"
+
+LOG_MODULE_REGISTER(max31341_emul, CONFIG_I2C_LOG_LEVEL);
+
+#define MAX31341_REG_CONFIG1    0x00
+#define MAX31341_REG_INT_EN     0x04
+#define MAX31341_REG_INT_STATUS 0x05
+#define MAX31341_REG_SECONDS    0x06
+#define MAX31341_REG_MINUTES    0x07
+#define MAX31341_REG_HOURS      0x08
+#define MAX31341_REG_DAY        0x09
+#define MAX31341_REG_DATE       0x0A
+#define MAX31341_REG_MONTH      0x0B
+#define MAX31341_REG_YEAR       0x0C
+#define MAX31341_REG_ALM1_SEC   0x0D
+#define MAX31341_REG_REV_ID     0x59
+#define MAX31341_REV_ID         0x01
+
+#define MAX31341_CONFIG1_ENOSC BIT(0)
+#define MAX31341_INT_A1        BIT(0)
+#define MAX31341_MONTH_CENTURY BIT(7)
+#define MAX31341_ALM_MASK      BIT(7)
+#define MAX31341_ALM_DY_DT     BIT(6)
+
+struct max31341_emul_cfg
+{
+    struct gpio_dt_spec int_gpio;
+};
+
+struct max31341_emul_data
+{
+    const struct emul* target;
+    uint8_t regs[MAX31341_EMUL_NUM_REGS];
+    uint8_t ptr;
+    struct k_timer osc; /**< 1 Hz oscillator, counts while ENOSC is set */
+
+    int fail_err;
+    uint32_t fail_count;
+    uint32_t transfers;
+
+    struct k_spinlock lock;
+};
+
+/* Increment a BCD field, wrapping from @p hi back to @p lo. Returns true on wrap. */
+static bool max31341_emul_bcd_inc(uint8_t* reg, uint8_t mask, uint8_t lo, uint8_t hi)
+{
+    uint8_t val = bcd2bin(*reg & mask) + 1;
+    bool wrap = val > hi;
+
+    *reg = (*reg & ~mask) | bin2bcd(wrap ? lo : val);
+    return wrap;
+}
+
+static uint8_t max31341_emul_days_in_month(const uint8_t* regs)
+{
+    static const uint8_t days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    uint8_t month = bcd2bin(regs[MAX31341_REG_MONTH] & 0x1F);
+    uint8_t year = bcd2bin(regs[MAX31341_REG_YEAR]);
+
+    if (month < 1 || month > 12) {
+        return 31;
+    }
+    return days[month - 1] + (month == 2 && year % 4 == 0);
+}
+
+static bool max31341_emul_alarm_match(const uint8_t* regs)
+{
+    const uint8_t* alm = &regs[MAX31341_REG_ALM1_SEC];
+
+    if (!(alm[0] & MAX31341_ALM_MASK) && (alm[0] & 0x7F) != (regs[MAX31341_REG_SECONDS] & 0x7F)) {
+        return false;
+    }
+    if (!(alm[1] & MAX31341_ALM_MASK) && (alm[1] & 0x7F) != (regs[MAX31341_REG_MINUTES] & 0x7F)) {
+        return false;
+    }
+    if (!(alm[2] & MAX31341_ALM_MASK) && (alm[2] & 0x3F) != (regs[MAX31341_REG_HOURS] & 0x3F)) {
+        return false;
+    }
+    if (!(alm[3] & MAX31341_ALM_MASK)) {
+        if (alm[3] & MAX31341_ALM_DY_DT) {
+            return (alm[3] & 0x07) == (regs[MAX31341_REG_DAY] & 0x07);
+        }
+        return (alm[3] & 0x3F) == (regs[MAX31341_REG_DATE] & 0x3F);
+    }
+    return true;
+}
+
+/* Drive the interrupt line from the flag and enable registers. Called without the lock. */
+static void max31341_emul_update_int(const struct emul* target, bool asserted)
+{
+#if CONFIG_GPIO_EMUL
+    const struct max31341_emul_cfg* cfg = target->cfg;
+
+    if (cfg->int_gpio.port) {
+        bool active_low = cfg->int_gpio.dt_flags & GPIO_ACTIVE_LOW;
+
+        (void)gpio_emul_input_set(cfg->int_gpio.port, cfg->int_gpio.pin, asserted != active_low);
+    }
+#else
+    ARG_UNUSED(target);
+    ARG_UNUSED(asserted);
+#endif
+}
+
+static bool max31341_emul_int_asserted(const uint8_t* regs)
+{
+    return regs[MAX31341_REG_INT_STATUS] & regs[MAX31341_REG_INT_EN] & MAX31341_INT_A1;
+}
+
+static void max31341_emul_osc_tick(struct k_timer* timer)
+{
+    struct max31341_emul_data* data = CONTAINER_OF(timer, struct max31341_emul_data, osc);
+    uint8_t* r = data->regs;
+    bool asserted;
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    if (!(r[MAX31341_REG_CONFIG1] & MAX31341_CONFIG1_ENOSC)) {
+        k_spin_unlock(&data->lock, key);
+        return;
+    }
+
+    if (max31341_emul_bcd_inc(&r[MAX31341_REG_SECONDS], 0x7F, 0, 59) && max31341_emul_bcd_inc(&r[MAX31341_REG_MINUTES], 0x7F, 0, 59) &&
+        max31341_emul_bcd_inc(&r[MAX31341_REG_HOURS], 0x3F, 0, 23)) {
+        (void)max31341_emul_bcd_inc(&r[MAX31341_REG_DAY], 0x07, 1, 7);
+        if (max31341_emul_bcd_inc(&r[MAX31341_REG_DATE], 0x3F, 1, max31341_emul_days_in_month(r)) &&
+            max31341_emul_bcd_inc(&r[MAX31341_REG_MONTH], 0x1F, 1, 12) && max31341_emul_bcd_inc(&r[MAX31341_REG_YEAR], 0xFF, 0, 99)) {
+            r[MAX31341_REG_MONTH] ^= MAX31341_MONTH_CENTURY;
+        }
+    }
+
+    if (max31341_emul_alarm_match(r)) {
+        r[MAX31341_REG_INT_STATUS] |= MAX31341_INT_A1;
+    }
+    asserted = max31341_emul_int_asserted(r);
+
+    k_spin_unlock(&data->lock, key);
+
+    max31341_emul_update_int(data->target, asserted);
+}
+
+static int max31341_emul_transfer(const struct emul* target, struct i2c_msg* msgs, int num_msgs, int addr)
+{
+    struct max31341_emul_data* data = target->data;
+    bool have_ptr = false;
+    bool asserted;
+    int ret = 0;
+
+    ARG_UNUSED(addr);
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    data->transfers++;
+    if (data->fail_count) {
+        data->fail_count--;
+        ret = data->fail_err;
+        goto out;
+    }
+
+    for (int i = 0; i < num_msgs; i++) {
+        struct i2c_msg* msg = &msgs[i];
+
+        if (msg->flags & I2C_MSG_READ) {
+            for (uint32_t j = 0; j < msg->len; j++) {
+                msg->buf[j] = data->regs[data->ptr];
+                data->ptr = (data->ptr + 1) % MAX31341_EMUL_NUM_REGS;
+            }
+            continue;
+        }
+
+        for (uint32_t j = 0; j < msg->len; j++) {
+            if (!have_ptr) {
+                if (msg->buf[j] >= MAX31341_EMUL_NUM_REGS) {
+                    ret = -EIO;
+                    goto out;
+                }
+                data->ptr = msg->buf[j];
+                have_ptr = true;
+                continue;
+            }
+            if (data->ptr != MAX31341_REG_REV_ID) {
+                data->regs[data->ptr] = msg->buf[j];
+            }
+            data->ptr = (data->ptr + 1) % MAX31341_EMUL_NUM_REGS;
+        }
+    }
+
+out:
+    asserted = max31341_emul_int_asserted(data->regs);
+    k_spin_unlock(&data->lock, key);
+
+    max31341_emul_update_int(target, asserted);
+    return ret;
+}
+
+static const struct i2c_emul_api max31341_emul_api = {
+    .transfer = max31341_emul_transfer,
+};
+
+int max31341_emul_set_reg(const struct emul* target, uint8_t reg, uint8_t val)
+{
+    struct max31341_emul_data* data = target->data;
+
+    if (reg >= MAX31341_EMUL_NUM_REGS) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    data->regs[reg] = val;
+    k_spin_unlock(&data->lock, key);
+    return 0;
+}
+
+int max31341_emul_get_reg(const struct emul* target, uint8_t reg, uint8_t* val)
+{
+    struct max31341_emul_data* data = target->data;
+
+    if (reg >= MAX31341_EMUL_NUM_REGS || !val) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    *val = data->regs[reg];
+    k_spin_unlock(&data->lock, key);
+    return 0;
+}
+
+void max31341_emul_inject_error(const struct emul* target, int err, uint32_t count)
+{
+    struct max31341_emul_data* data = target->data;
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    data->fail_err = err;
+    data->fail_count = count;
+    k_spin_unlock(&data->lock, key);
+}
+
+uint32_t max31341_emul_transfers(const struct emul* target)
+{
+    struct max31341_emul_data* data = target->data;
+
+    return data->transfers;
+}
+
+static int max31341_emul_init(const struct emul* target, const struct device* parent)
+{
+    struct max31341_emul_data* data = target->data;
+
+    ARG_UNUSED(parent);
+
+    data->target = target;
+    memset(data->regs, 0, sizeof(data->regs));
+    data->regs[MAX31341_REG_DAY] = 1;
+    data->regs[MAX31341_REG_DATE] = 1;
+    data->regs[MAX31341_REG_MONTH] = 1;
+    data->regs[MAX31341_REG_REV_ID] = MAX31341_REV_ID;
+    data->ptr = 0;
+
+    k_timer_init(&data->osc, max31341_emul_osc_tick, NULL);
+    k_timer_start(&data->osc, K_SECONDS(1), K_SECONDS(1));
+    return 0;
+}
+
+/* Without the driver the emulator provides an empty device for the node */
+#if CONFIG_RTC_MAX31341
+    #define MAX31341_EMUL_DEVICE(n)
+#else
+    #define MAX31341_EMUL_DEVICE(n) DEVICE_DT_INST_DEFINE(n, NULL, NULL, NULL, NULL, POST_KERNEL, CONFIG_I2C_INIT_PRIORITY, NULL);
+#endif
+
+#define MAX31341_EMUL(n)                                                                                                                   \
+    static const struct max31341_emul_cfg max31341_emul_cfg_##n = {                                                                        \
+        .int_gpio = GPIO_DT_SPEC_INST_GET_OR(n, int_gpios, {0}),                                                                           \
+    };                                                                                                                                     \
+    static struct max31341_emul_data max31341_emul_data_##n;                                                                               \
+    MAX31341_EMUL_DEVICE(n)                                                                                                                \
+    EMUL_DT_INST_DEFINE(n, max31341_emul_init, &max31341_emul_data_##n, &max31341_emul_cfg_##n, &max31341_emul_api, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(MAX31341_EMUL)
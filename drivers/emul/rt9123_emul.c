@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT richtek_rt9123
+
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/logging/log.h>
+
+#include "emul/rt9123_emul.h"
+
+LOG_MODULE_REGISTER(rt9123_emul, CONFIG_I2C_LOG_LEVEL);
+
+/* Register 0x00 reads back a fixed ID so drivers can probe the emulator */
+#define RT9123_REG_COMBO_ID  0x00
+#define RT9123_EMUL_COMBO_ID 0x4600
+
+struct rt9123_emul_data
+{
+    uint16_t regs[RT9123_EMUL_NUM_REGS];
+    uint8_t ptr;
+    uint32_t delay_us;
+
+    struct k_spinlock lock;
+};
+
+static int rt9123_emul_transfer(const struct emul* target, struct i2c_msg* msgs, int num_msgs, int addr)
+{
+    struct rt9123_emul_data* data = target->data;
+    bool have_ptr = false;
+    bool lsb = false;
+    uint8_t msb = 0;
+    int ret = 0;
+
+    ARG_UNUSED(addr);
+
+    if (data->delay_us) {
+        k_busy_wait(data->delay_us);
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    for (int i = 0; i < num_msgs; i++) {
+        struct i2c_msg* msg = &msgs[i];
+
+        if (msg->flags & I2C_MSG_READ) {
+            lsb = false;
+            for (uint32_t j = 0; j < msg->len; j++) {
+                uint16_t val = data->regs[data->ptr];
+
+                if (!lsb) {
+                    msg->buf[j] = val >> 8;
+                }
+                else {
+                    msg->buf[j] = val & 0xFF;
+                    data->ptr = (data->ptr + 1) % RT9123_EMUL_NUM_REGS;
+                }
+                lsb = !lsb;
+            }
+            continue;
+        }
+
+        for (uint32_t j = 0; j < msg->len; j++) {
+            if (!have_ptr) {
+                if (msg->buf[j] >= RT9123_EMUL_NUM_REGS) {
+                    ret = -EIO;
+                    goto out;
+                }
+                data->ptr = msg->buf[j];
+                have_ptr = true;
+                continue;
+            }
+            if (!lsb) {
+                msb = msg->buf[j];
+            }
+            else {
+                if (data->ptr != RT9123_REG_COMBO_ID) {
+                    data->regs[data->ptr] = (msb << 8) | msg->buf[j];
+                }
+                data->ptr = (data->ptr + 1) % RT9123_EMUL_NUM_REGS;
+            }
+            lsb = !lsb;
+        }
+    }
+
+out:
+    k_spin_unlock(&data->lock, key);
+    return ret;
+}
+
+static const struct i2c_emul_api rt9123_emul_api = {
+    .transfer = rt9123_emul_transfer,
+};
+
+int rt9123_emul_set_reg(const struct emul* target, uint8_t reg, uint16_t val)
+{
+    struct rt9123_emul_data* data = target->data;
+
+    if (reg >= RT9123_EMUL_NUM_REGS) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    data->regs[reg] = val;
+    k_spin_unlock(&data->lock, key);
+    return 0;
+}
+
+int rt9123_emul_get_reg(const struct emul* target, uint8_t reg, uint16_t* val)
+{
+    struct rt9123_emul_data* data = target->data;
+
+    if (reg >= RT9123_EMUL_NUM_REGS || !val) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    *val = data->regs[reg];
+    k_spin_unlock(&data->lock, key);
+    return 0;
+}
+
+void rt9123_emul_set_delay(const struct emul* target, uint32_t us)
+{
+    struct rt9123_emul_data* data = target->data;
+
+    data->delay_us = us;
+}
+
+static int rt9123_emul_init(const struct emul* target, const struct device* parent)
+{
+    struct rt9123_emul_data* data = target->data;
+
+    ARG_UNUSED(parent);
+
+    memset(data->regs, 0, sizeof(data->regs));
+    data->regs[RT9123_REG_COMBO_ID] = RT9123_EMUL_COMBO_ID;
+    data->ptr = 0;
+    return 0;
+}
+
+/* No driver binds to the node, so the emulator provides an empty device */
+#define RT9123_EMUL(n)                                                                                                                     \
+    static struct rt9123_emul_data rt9123_emul_data_##n;                                                                                   \
+    DEVICE_DT_INST_DEFINE(n, NULL, NULL, NULL, NULL, POST_KERNEL, CONFIG_I2C_INIT_PRIORITY, NULL);                                         \
+    EMUL_DT_INST_DEFINE(n, rt9123_emul_init, &rt9123_emul_data_##n, NULL, &rt9123_emul_api, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(RT9123_EMUL)
@@ -0,0 +1,457 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT adi_max31341
+
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/rtc.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(max31341, CONFIG_RTC_LOG_LEVEL);
+
+#define MAX31341_REG_CONFIG1    0x00
+#define MAX31341_REG_CONFIG2    0x01
+#define MAX31341_REG_INT_EN     0x04
+#define MAX31341_REG_INT_STATUS 0x05
+#define MAX31341_REG_SECONDS    0x06
+#define MAX31341_REG_ALM1_SEC   0x0D
+#define MAX31341_REG_REV_ID     0x59
+
+#define MAX31341_CONFIG1_ENOSC   BIT(0)
+#define MAX31341_CONFIG2_SET_RTC BIT(1)
+#define MAX31341_INT_A1          BIT(0)
+
+#define MAX31341_MONTH_CENTURY BIT(7)
+#define MAX31341_ALM_MASK      BIT(7)
+#define MAX31341_ALM_DY_DT     BIT(6)
+
+#define MAX31341_TIME_REGS 7
+#define MAX31341_ALM1_REGS 4
+
+#define MAX31341_ALARM_FIELDS                                                                                                              \
+    (RTC_ALARM_TIME_MASK_SECOND | RTC_ALARM_TIME_MASK_MINUTE | RTC_ALARM_TIME_MASK_HOUR | RTC_ALARM_TIME_MASK_MONTHDAY |                  \
+     RTC_ALARM_TIME_MASK_WEEKDAY)
+
+struct max31341_config
+{
+    struct i2c_dt_spec i2c;
+#if CONFIG_RTC_ALARM
+    struct gpio_dt_spec int_gpio;
+#endif
+};
+
+struct max31341_data
+{
+    struct k_mutex lock;
+#if CONFIG_RTC_ALARM
+    const struct device* dev;
+    struct gpio_callback int_cb;
+    struct k_work alarm_work;
+    rtc_alarm_callback alarm_cb;
+    void* alarm_user_data;
+    bool alarm_pending;
+#endif
+};
+
+static bool max31341_time_valid(const struct rtc_time* t)
+{
+    return t->tm_sec >= 0 && t->tm_sec <= 59 && t->tm_min >= 0 && t->tm_min <= 59 && t->tm_hour >= 0 && t->tm_hour <= 23 &&
+           t->tm_mday >= 1 && t->tm_mday <= 31 && t->tm_mon >= 0 && t->tm_mon <= 11 && t->tm_year >= 100 && t->tm_year <= 299 &&
+           t->tm_wday >= 0 && t->tm_wday <= 6;
+}
+
+static int max31341_set_time(const struct device* dev, const struct rtc_time* timeptr)
+{
+    const struct max31341_config* config = dev->config;
+    struct max31341_data* data = dev->data;
+    uint8_t regs[MAX31341_TIME_REGS];
+    int ret;
+
+    if (!timeptr || !max31341_time_valid(timeptr)) {
+        return -EINVAL;
+    }
+
+    regs[0] = bin2bcd(timeptr->tm_sec);
+    regs[1] = bin2bcd(timeptr->tm_min);
+    regs[2] = bin2bcd(timeptr->tm_hour);
+    regs[3] = timeptr->tm_wday + 1;
+    regs[4] = bin2bcd(timeptr->tm_mday);
+    regs[5] = bin2bcd(timeptr->tm_mon + 1) | (timeptr->tm_year >= 200 ? MAX31341_MONTH_CENTURY : 0);
+    regs[6] = bin2bcd(timeptr->tm_year % 100);
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+
+    ret = i2c_burst_write_dt(&config->i2c, MAX31341_REG_SECONDS, regs, sizeof(regs));
+    if (ret == 0) {
+        /* The written time only takes effect on a SET_RTC pulse */
+        ret = i2c_reg_update_byte_dt(&config->i2c, MAX31341_REG_CONFIG2, MAX31341_CONFIG2_SET_RTC, MAX31341_CONFIG2_SET_RTC);
+    }
+    if (ret == 0) {
+        ret = i2c_reg_update_byte_dt(&config->i2c, MAX31341_REG_CONFIG2, MAX31341_CONFIG2_SET_RTC, 0);
+    }
+
+    k_mutex_unlock(&data->lock);
+
+    if (ret) {
+        LOG_ERR("Failed to set time (%d)", ret);
+    }
+    return ret;
+}
+
+static int max31341_get_time(const struct device* dev, struct rtc_time* timeptr)
+{
+    const struct max31341_config* config = dev->config;
+    struct max31341_data* data = dev->data;
+    uint8_t regs[MAX31341_TIME_REGS];
+    int ret;
+
+    if (!timeptr) {
+        return -EINVAL;
+    }
+
+    /* One burst so the fields cannot roll over between reads */
+    k_mutex_lock(&data->lock, K_FOREVER);
+    ret = i2c_burst_read_dt(&config->i2c, MAX31341_REG_SECONDS, regs, sizeof(regs));
+    k_mutex_unlock(&data->lock);
+    if (ret) {
+        return ret;
+    }
+
+    timeptr->tm_sec = bcd2bin(regs[0] & 0x7F);
+    timeptr->tm_min = bcd2bin(regs[1] & 0x7F);
+    timeptr->tm_hour = bcd2bin(regs[2] & 0x3F);
+    timeptr->tm_wday = (regs[3] & 0x07) - 1;
+    timeptr->tm_mday = bcd2bin(regs[4] & 0x3F);
+    timeptr->tm_mon = bcd2bin(regs[5] & 0x1F) - 1;
+    timeptr->tm_year = bcd2bin(regs[6]) + ((regs[5] & MAX31341_MONTH_CENTURY) ? 200 : 100);
+    timeptr->tm_yday = -1;
+    timeptr->tm_isdst = -1;
+    timeptr->tm_nsec = 0;
+
+    return 0;
+}
+
+#if CONFIG_RTC_ALARM
+/* Read and clear the alarm 1 flag. Caller holds the lock. */
+static int max31341_alarm_take_flag(const struct device* dev, bool* fired)
+{
+    const struct max31341_config* config = dev->config;
+    uint8_t status;
+    int ret = i2c_reg_read_byte_dt(&config->i2c, MAX31341_REG_INT_STATUS, &status);
+
+    if (ret) {
+        return ret;
+    }
+
+    *fired = status & MAX31341_INT_A1;
+    if (*fired) {
+        ret = i2c_reg_write_byte_dt(&config->i2c, MAX31341_REG_INT_STATUS, status & ~MAX31341_INT_A1);
+    }
+    return ret;
+}
+
+static int max31341_alarm_get_supported_fields(const struct device* dev, uint16_t id, uint16_t* mask)
+{
+    ARG_UNUSED(dev);
+
+    if (id != 0 || !mask) {
+        return -EINVAL;
+    }
+
+    *mask = MAX31341_ALARM_FIELDS;
+    return 0;
+}
+
+static int max31341_alarm_set_time(const struct device* dev, uint16_t id, uint16_t mask, const struct rtc_time* timeptr)
+{
+    const struct max31341_config* config = dev->config;
+    struct max31341_data* data = dev->data;
+    uint8_t regs[MAX31341_ALM1_REGS];
+    bool fired;
+    int ret;
+
+    if (id != 0 || (mask & ~MAX31341_ALARM_FIELDS)) {
+        return -EINVAL;
+    }
+    if ((mask & RTC_ALARM_TIME_MASK_MONTHDAY) && (mask & RTC_ALARM_TIME_MASK_WEEKDAY)) {
+        return -EINVAL;
+    }
+    if (mask && !timeptr) {
+        return -EINVAL;
+    }
+    if (mask) {
+        if (((mask & RTC_ALARM_TIME_MASK_SECOND) && (timeptr->tm_sec < 0 || timeptr->tm_sec > 59)) ||
+            ((mask & RTC_ALARM_TIME_MASK_MINUTE) && (timeptr->tm_min < 0 || timeptr->tm_min > 59)) ||
+            ((mask & RTC_ALARM_TIME_MASK_HOUR) && (timeptr->tm_hour < 0 || timeptr->tm_hour > 23)) ||
+            ((mask & RTC_ALARM_TIME_MASK_MONTHDAY) && (timeptr->tm_mday < 1 || timeptr->tm_mday > 31)) ||
+            ((mask & RTC_ALARM_TIME_MASK_WEEKDAY) && (timeptr->tm_wday < 0 || timeptr->tm_wday > 6))) {
+            return -EINVAL;
+        }
+    }
+
+    /* A set mask bit in the register means "don't care" */
+    regs[0] = (mask & RTC_ALARM_TIME_MASK_SECOND) ? bin2bcd(timeptr->tm_sec) : MAX31341_ALM_MASK;
+    regs[1] = (mask & RTC_ALARM_TIME_MASK_MINUTE) ? bin2bcd(timeptr->tm_min) : MAX31341_ALM_MASK;
+    regs[2] = (mask & RTC_ALARM_TIME_MASK_HOUR) ? bin2bcd(timeptr->tm_hour) : MAX31341_ALM_MASK;
+    if (mask & RTC_ALARM_TIME_MASK_WEEKDAY) {
+        regs[3] = MAX31341_ALM_DY_DT | (timeptr->tm_wday + 1);
+    }
+    else if (mask & RTC_ALARM_TIME_MASK_MONTHDAY) {
+        regs[3] = bin2bcd(timeptr->tm_mday);
+    }
+    else {
+        regs[3] = MAX31341_ALM_MASK;
+    }
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+
+    /* Disable while the registers are inconsistent and drop a stale flag */
+    ret = i2c_reg_update_byte_dt(&config->i2c, MAX31341_REG_INT_EN, MAX31341_INT_A1, 0);
+    if (ret == 0) {
+        ret = max31341_alarm_take_flag(dev, &fired);
+    }
+    data->alarm_pending = false;
+    if (ret == 0 && mask) {
+        ret = i2c_burst_write_dt(&config->i2c, MAX31341_REG_ALM1_SEC, regs, sizeof(regs));
+        if (ret == 0) {
+            ret = i2c_reg_update_byte_dt(&config->i2c, MAX31341_REG_INT_EN, MAX31341_INT_A1, MAX31341_INT_A1);
+        }
+    }
+
+    k_mutex_unlock(&data->lock);
+    return ret;
+}
+
+static int max31341_alarm_get_time(const struct device* dev, uint16_t id, uint16_t* mask, struct rtc_time* timeptr)
+{
+    const struct max31341_config* config = dev->config;
+    struct max31341_data* data = dev->data;
+    uint8_t regs[MAX31341_ALM1_REGS];
+    uint8_t int_en;
+    int ret;
+
+    if (id != 0 || !mask || !timeptr) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    ret = i2c_reg_read_byte_dt(&config->i2c, MAX31341_REG_INT_EN, &int_en);
+    if (ret == 0) {
+        ret = i2c_burst_read_dt(&config->i2c, MAX31341_REG_ALM1_SEC, regs, sizeof(regs));
+    }
+    k_mutex_unlock(&data->lock);
+    if (ret) {
+        return ret;
+    }
+
+    memset(timeptr, 0, sizeof(*timeptr));
+    *mask = 0;
+    if (!(int_en & MAX31341_INT_A1)) {
+        return 0;
+    }
+
+    if (!(regs[0] & MAX31341_ALM_MASK)) {
+        timeptr->tm_sec = bcd2bin(regs[0] & 0x7F);
+        *mask |= RTC_ALARM_TIME_MASK_SECOND;
+    }
+    if (!(regs[1] & MAX31341_ALM_MASK)) {
+        timeptr->tm_min = bcd2bin(regs[1] & 0x7F);
+        *mask |= RTC_ALARM_TIME_MASK_MINUTE;
+    }
+    if (!(regs[2] & MAX31341_ALM_MASK)) {
+        timeptr->tm_hour = bcd2bin(regs[2] & 0x3F);
+        *mask |= RTC_ALARM_TIME_MASK_HOUR;
+    }
+    if (!(regs[3] & MAX31341_ALM_MASK)) {
+        if (regs[3] & MAX31341_ALM_DY_DT) {
+            timeptr->tm_wday = (regs[3] & 0x07) - 1;
+            *mask |= RTC_ALARM_TIME_MASK_WEEKDAY;
+        }
+        else {
+            timeptr->tm_mday = bcd2bin(regs[3] & 0x3F);
+            *mask |= RTC_ALARM_TIME_MASK_MONTHDAY;
+        }
+    }
+
+    return 0;
+}
+
+static int max31341_alarm_is_pending(const struct device* dev, uint16_t id)
+{
+    struct max31341_data* data = dev->data;
+    bool fired = false;
+    int ret;
+
+    if (id != 0) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    ret = max31341_alarm_take_flag(dev, &fired);
+    fired |= data->alarm_pending;
+    data->alarm_pending = false;
+    k_mutex_unlock(&data->lock);
+
+    return ret ? ret : fired;
+}
+
+static int max31341_alarm_set_callback(const struct device* dev, uint16_t id, rtc_alarm_callback callback, void* user_data)
+{
+    const struct max31341_config* config = dev->config;
+    struct max31341_data* data = dev->data;
+
+    if (id != 0) {
+        return -EINVAL;
+    }
+    if (!config->int_gpio.port) {
+        return -ENOTSUP;
+    }
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    data->alarm_cb = callback;
+    data->alarm_user_data = user_data;
+    k_mutex_unlock(&data->lock);
+
+    /* Deliver an alarm that fired while no callback was set */
+    if (callback) {
+        k_work_submit(&data->alarm_work);
+    }
+    return 0;
+}
+
+static void max31341_alarm_work_handler(struct k_work* work)
+{
+    struct max31341_data* data = CONTAINER_OF(work, struct max31341_data, alarm_work);
+    rtc_alarm_callback cb;
+    void* user_data;
+    bool fired = false;
+
+    k_mutex_lock(&data->lock, K_FOREVER);
+    if (max31341_alarm_take_flag(data->dev, &fired)) {
+        LOG_ERR("Failed to read interrupt status");
+    }
+    fired |= data->alarm_pending;
+    cb = data->alarm_cb;
+    user_data = data->alarm_user_data;
+    data->alarm_pending = fired && !cb;
+    k_mutex_unlock(&data->lock);
+
+    if (fired && cb) {
+        cb(data->dev, 0, user_data);
+    }
+}
+
+static void max31341_int_handler(const struct device* port, struct gpio_callback* cb, gpio_port_pins_t pins)
+{
+    struct max31341_data* data = CONTAINER_OF(cb, struct max31341_data, int_cb);
+
+    ARG_UNUSED(port);
+    ARG_UNUSED(pins);
+
+    /* The status register is on the bus, read it from thread context */
+    k_work_submit(&data->alarm_work);
+}
+
+static int max31341_init_alarm(const struct device* dev)
+{
+    const struct max31341_config* config = dev->config;
+    struct max31341_data* data = dev->data;
+    int ret;
+
+    data->dev = dev;
+    k_work_init(&data->alarm_work, max31341_alarm_work_handler);
+
+    if (!config->int_gpio.port) {
+        return 0;
+    }
+    if (!gpio_is_ready_dt(&config->int_gpio)) {
+        LOG_ERR("Interrupt GPIO not ready");
+        return -ENODEV;
+    }
+
+    ret = gpio_pin_configure_dt(&config->int_gpio, GPIO_INPUT);
+    if (ret < 0) {
+        LOG_ERR("Could not configure interrupt GPIO (%d)", ret);
+        return ret;
+    }
+
+    gpio_init_callback(&data->int_cb, max31341_int_handler, BIT(config->int_gpio.pin));
+    ret = gpio_add_callback_dt(&config->int_gpio, &data->int_cb);
+    if (ret < 0) {
+        return ret;
+    }
+
+    return gpio_pin_interrupt_configure_dt(&config->int_gpio, GPIO_INT_EDGE_TO_ACTIVE);
+}
+#endif /* CONFIG_RTC_ALARM */
+
+static DEVICE_API(rtc, max31341_api) = {
+    .set_time = max31341_set_time,
+    .get_time = max31341_get_time,
+#if CONFIG_RTC_ALARM
+    .alarm_get_supported_fields = max31341_alarm_get_supported_fields,
+    .alarm_set_time = max31341_alarm_set_time,
+    .alarm_get_time = max31341_alarm_get_time,
+    .alarm_is_pending = max31341_alarm_is_pending,
+    .alarm_set_callback = max31341_alarm_set_callback,
+#endif
+};
+
+static int max31341_init(const struct device* dev)
+{
+    const struct max31341_config* config = dev->config;
+    struct max31341_data* data = dev->data;
+    uint8_t rev;
+    int ret;
+
+    k_mutex_init(&data->lock);
+
+    if (!i2c_is_ready_dt(&config->i2c)) {
+        LOG_ERR("I2C bus not ready");
+        return -ENODEV;
+    }
+
+    ret = i2c_reg_read_byte_dt(&config->i2c, MAX31341_REG_REV_ID, &rev);
+    if (ret) {
+        LOG_ERR("Failed to read revision (%d)", ret);
+        return ret;
+    }
+    LOG_DBG("Revision 0x%02X", rev);
+
+    ret = i2c_reg_update_byte_dt(&config->i2c, MAX31341_REG_CONFIG1, MAX31341_CONFIG1_ENOSC, MAX31341_CONFIG1_ENOSC);
+    if (ret) {
+        LOG_ERR("Failed to enable oscillator (%d)", ret);
+        return ret;
+    }
+
+#if CONFIG_RTC_ALARM
+    return max31341_init_alarm(dev);
+#else
+    return 0;
+#endif
+}
+
+#if CONFIG_RTC_ALARM
+    #define MAX31341_INT_GPIO(i) .int_gpio = GPIO_DT_SPEC_INST_GET_OR(i, int_gpios, {0}),
+#else
+    #define MAX31341_INT_GPIO(i)
+#endif
+
+#define MAX31341_INIT(i)                                                                                                                   \
+    static struct max31341_data max31341_data_##i;                                                                                         \
+                                                                                                                                           \
+    static const struct max31341_config max31341_config_##i = {                                                                            \
+        .i2c = I2C_DT_SPEC_INST_GET(i),                                                                                                    \
+        MAX31341_INT_GPIO(i)                                                                                                               \
+    };                                                                                                                                     \
+                                                                                                                                           \
+    DEVICE_DT_INST_DEFINE(i, max31341_init, NULL, &max31341_data_##i, &max31341_config_##i, POST_KERNEL, CONFIG_RTC_INIT_PRIORITY,         \
+                          &max31341_api);
+
+DT_INST_FOREACH_STATUS_OKAY(MAX31341_INIT)
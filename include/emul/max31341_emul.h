@@ -0,0 +1,69 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file max31341_emul.h
+ * @brief Backend API of the MAX31341 I2C emulator.
+ *
+ * The emulator models the register file with an auto-incrementing register
+ * pointer, like the real part. While ENOSC is set the time registers count
+ * once per second and alarm 1 raises its flag and, if enabled, asserts the
+ * interrupt line on an emulated GPIO. Tests and samples use these calls to
+ * preset registers, inspect what was written and inject bus errors.
+ */
+
+#ifndef MAX31341_EMUL_H_
+#define MAX31341_EMUL_H_
+
+#include <zephyr/drivers/emul.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Number of emulated registers. */
+#define MAX31341_EMUL_NUM_REGS 0x60
+
+/**
+ * @brief Set a register value, bypassing the bus.
+ *
+ * @param target Emulator pointer.
+ * @param reg Register address.
+ * @param val Register value.
+ * @return 0 on success, -EINVAL if @p reg is out of range.
+ */
+int max31341_emul_set_reg(const struct emul* target, uint8_t reg, uint8_t val);
+
+/**
+ * @brief Get a register value, bypassing the bus.
+ *
+ * @param target Emulator pointer.
+ * @param reg Register address.
+ * @param val Output for the register value.
+ * @return 0 on success, -EINVAL if @p reg is out of range.
+ */
+int max31341_emul_get_reg(const struct emul* target, uint8_t reg, uint8_t* val);
+
+/**
+ * @brief Fail the next transfers.
+ *
+ * @param target Emulator pointer.
+ * @param err Negative errno returned by the failing transfers.
+ * @param count Number of transfers to fail, 0 to stop injecting.
+ */
+void max31341_emul_inject_error(const struct emul* target, int err, uint32_t count);
+
+/**
+ * @brief Number of transfers addressed to the emulator so far.
+ *
+ * @param target Emulator pointer.
+ * @return Transfer count, including failed ones.
+ */
+uint32_t max31341_emul_transfers(const struct emul* target);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file rt9123_emul.h
+ * @brief Backend API of the RT9123 I2C emulator.
+ *
+ * The RT9123 uses 8-bit register addresses and 16-bit big-endian values. The
+ * register pointer advances by one register per two data bytes.
+ */
+
+#ifndef RT9123_EMUL_H_
+#define RT9123_EMUL_H_
+
+#include <zephyr/drivers/emul.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Number of emulated registers. */
+#define RT9123_EMUL_NUM_REGS 0x80
+
+/**
+ * @brief Set a register value, bypassing the bus.
+ *
+ * @param target Emulator pointer.
+ * @param reg Register address.
+ * @param val Register value.
+ * @return 0 on success, -EINVAL if @p reg is out of range.
+ */
+int rt9123_emul_set_reg(const struct emul* target, uint8_t reg, uint16_t val);
+
+/**
+ * @brief Get a register value, bypassing the bus.
+ *
+ * @param target Emulator pointer.
+ * @param reg Register address.
+ * @param val Output for the register value.
+ * @return 0 on success, -EINVAL if @p reg is out of range.
+ */
+int rt9123_emul_get_reg(const struct emul* target, uint8_t reg, uint16_t* val);
+
+/**
+ * @brief Delay every transfer by a busy wait, to model a slow target.
+ *
+ * @param target Emulator pointer.
+ * @param us Delay in microseconds, 0 to disable.
+ */
+void rt9123_emul_set_delay(const struct emul* target, uint32_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
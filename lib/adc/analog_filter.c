@@ -0,0 +1,106 @@
+#include <errno.h>
+#include <string.h>
+
+#include "analog_filter.h"
+
+int analog_filter_init(struct analog_filter* f, enum analog_filter_type type, uint8_t param)
+{
+    if (!f) {
+        return -EINVAL;
+    }
+
+    switch (type) {
+    case ANALOG_FILTER_NONE:
+        break;
+    case ANALOG_FILTER_MOVING_AVG:
+    case ANALOG_FILTER_MEDIAN:
+        if (param < 1 || param > CONFIG_ANALOG_WRAPPER_FILTER_WINDOW) {
+            return -EINVAL;
+        }
+        break;
+    case ANALOG_FILTER_IIR:
+        if (param < 1 || param > 16) {
+            return -EINVAL;
+        }
+        break;
+    default:
+        return -EINVAL;
+    }
+
+    f->type = type;
+    f->param = param;
+    analog_filter_reset(f);
+    return 0;
+}
+
+void analog_filter_reset(struct analog_filter* f)
+{
+    memset(f->window, 0, sizeof(f->window));
+    f->count = 0;
+    f->head = 0;
+    f->acc = 0;
+}
+
+/* Rounded division that is symmetric around zero */
+static int32_t analog_filter_div_round(int64_t num, int32_t den)
+{
+    return (int32_t)((num >= 0 ? num + den / 2 : num - den / 2) / den);
+}
+
+static int32_t analog_filter_median(const struct analog_filter* f)
+{
+    int32_t sorted[CONFIG_ANALOG_WRAPPER_FILTER_WINDOW];
+    uint8_t n = f->count;
+
+    /* Insertion sort, the window is small */
+    for (uint8_t i = 0; i < n; i++) {
+        int32_t v = f->window[i];
+        uint8_t j = i;
+
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+
+    if (n & 1) {
+        return sorted[n / 2];
+    }
+    return analog_filter_div_round((int64_t)sorted[n / 2 - 1] + sorted[n / 2], 2);
+}
+
+int32_t analog_filter_update(struct analog_filter* f, int32_t x)
+{
+    switch (f->type) {
+    case ANALOG_FILTER_MOVING_AVG:
+    case ANALOG_FILTER_MEDIAN:
+        if (f->count == f->param) {
+            f->acc -= f->window[f->head];
+        }
+        else {
+            f->count++;
+        }
+        f->window[f->head] = x;
+        f->acc += x;
+        f->head = (f->head + 1) % f->param;
+
+        if (f->type == ANALOG_FILTER_MEDIAN) {
+            return analog_filter_median(f);
+        }
+        return analog_filter_div_round(f->acc, f->count);
+
+    case ANALOG_FILTER_IIR:
+        if (f->count == 0) {
+            f->acc = (int64_t)x << 16;
+            f->count = 1;
+        }
+        else {
+            f->acc += (((int64_t)x << 16) - f->acc) >> f->param;
+        }
+        return (int32_t)((f->acc + (1 << 15)) >> 16);
+
+    default:
+        return x;
+    }
+}
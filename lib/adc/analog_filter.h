@@ -0,0 +1,80 @@
+/**
+ * @file analog_filter.h
+ * @brief Integer smoothing filters for ADC readings.
+ *
+ * Moving average, first-order IIR and median filters on int32_t samples,
+ * using integer arithmetic only so they are cheap on cores without an FPU
+ * and need no soft-float library.
+ */
+
+#ifndef ANALOG_FILTER_H_
+#define ANALOG_FILTER_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Filter type.
+ */
+enum analog_filter_type {
+    ANALOG_FILTER_NONE,       /**< Pass samples through */
+    ANALOG_FILTER_MOVING_AVG, /**< Mean of the last N samples */
+    ANALOG_FILTER_IIR,        /**< y += (x - y) / 2^k */
+    ANALOG_FILTER_MEDIAN,     /**< Median of the last N samples */
+};
+
+/**
+ * @brief Filter state.
+ */
+struct analog_filter
+{
+    enum analog_filter_type type;
+    uint8_t param; /**< Window length N, or shift k for the IIR */
+
+    int32_t window[CONFIG_ANALOG_WRAPPER_FILTER_WINDOW]; /**< Last N samples */
+    uint8_t count;                                       /**< Valid samples in window */
+    uint8_t head;                                        /**< Next slot to overwrite */
+    int64_t acc;                                         /**< Running sum, or IIR state in Q16 */
+};
+
+/**
+ * @brief Initialize a filter.
+ *
+ * @param f     Filter pointer
+ * @param type  Filter type
+ * @param param Window length 1..CONFIG_ANALOG_WRAPPER_FILTER_WINDOW for the
+ *              moving average and median, shift 1..16 for the IIR, ignored
+ *              for ANALOG_FILTER_NONE
+ *
+ * @retval 0 On success
+ * @retval -EINVAL Invalid arguments
+ */
+int analog_filter_init(struct analog_filter* f, enum analog_filter_type type, uint8_t param);
+
+/**
+ * @brief Drop the filter history, keeping type and parameter.
+ *
+ * @param f Filter pointer
+ */
+void analog_filter_reset(struct analog_filter* f);
+
+/**
+ * @brief Feed one sample and get the filtered value.
+ *
+ * Until the window is full the moving average and median work on the
+ * samples seen so far; the IIR starts from the first sample.
+ *
+ * @param f Filter pointer
+ * @param x New sample
+ * @return Filtered value
+ */
+int32_t analog_filter_update(struct analog_filter* f, int32_t x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,107 @@
+#include "analog_group.h"
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(analog_wrp, CONFIG_ANALOG_WRAPPER_LOG_LEVEL);
+
+int analog_group_init(struct analog_group* grp)
+{
+    if (!grp || !grp->specs || grp->num == 0 || grp->num > CONFIG_ANALOG_WRAPPER_GROUP_MAX_CHANNELS) {
+        return -EINVAL;
+    }
+
+    const struct adc_dt_spec* first = &grp->specs[0];
+    uint32_t channels = 0;
+
+    if (!adc_is_ready_dt(first)) {
+        LOG_ERR("ADC device %s is not ready", first->dev->name);
+        return -ENODEV;
+    }
+
+    /* The nRF SAADC can only oversample a single-channel sequence */
+    if (grp->num > 1 && first->oversampling) {
+        LOG_ERR("oversampling is not supported for a group of %zu channels", grp->num);
+        return -EINVAL;
+    }
+
+    for (size_t i = 0; i < grp->num; i++) {
+        const struct adc_dt_spec* spec = &grp->specs[i];
+
+        if (spec->dev != first->dev || spec->resolution != first->resolution || spec->oversampling != first->oversampling ||
+            (channels & BIT(spec->channel_id))) {
+            LOG_ERR("group channel %u does not fit the group", spec->channel_id);
+            return -EINVAL;
+        }
+        channels |= BIT(spec->channel_id);
+
+        int retval = adc_channel_setup_dt(spec);
+
+        if (0 != retval) {
+            LOG_ERR("could not configure analog input %u |%d|", spec->channel_id, retval);
+            return retval;
+        }
+    }
+
+    /* The driver stores results in ascending channel-id order */
+    for (size_t i = 0; i < grp->num; i++) {
+        grp->slot[i] = POPCOUNT(channels & (BIT(grp->specs[i].channel_id) - 1));
+    }
+
+    int retval = adc_sequence_init_dt(first, &grp->seq);
+
+    if (0 != retval) {
+        LOG_ERR("could not init sequence |%d|", retval);
+        return retval;
+    }
+
+    grp->seq.channels = channels;
+    grp->seq.buffer = grp->buf;
+    grp->seq.buffer_size = grp->num * sizeof(grp->buf[0]);
+    grp->seq.calibrate = true;
+
+    return 0;
+}
+
+int analog_group_read(struct analog_group* grp, int16_t* raw, size_t num)
+{
+    if (!grp || !raw || num < grp->num) {
+        return -EINVAL;
+    }
+
+    int retval = adc_read(grp->specs[0].dev, &grp->seq);
+
+    if (retval) {
+        LOG_ERR("ADC group read failed (%d)", retval);
+        return retval;
+    }
+    grp->seq.calibrate = false;
+
+    for (size_t i = 0; i < grp->num; i++) {
+        raw[i] = grp->buf[grp->slot[i]];
+    }
+
+    return 0;
+}
+
+int analog_group_read_mv(struct analog_group* grp, int32_t* mv, size_t num)
+{
+    if (!mv) {
+        return -EINVAL;
+    }
+
+    int16_t raw[CONFIG_ANALOG_WRAPPER_GROUP_MAX_CHANNELS];
+    int retval = analog_group_read(grp, raw, num);
+
+    if (retval) {
+        return retval;
+    }
+
+    for (size_t i = 0; i < grp->num; i++) {
+        mv[i] = raw[i];
+        retval = adc_raw_to_millivolts_dt(&grp->specs[i], &mv[i]);
+        if (retval) {
+            return retval;
+        }
+    }
+
+    return 0;
+}
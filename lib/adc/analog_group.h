@@ -0,0 +1,102 @@
+/**
+ * @file analog_group.h
+ * @brief Multi-channel scan on one ADC.
+ *
+ * Reads several channels with a single adc_read(): one sequence with all
+ * channel bits set, so the ADC is powered up, calibrated and started once
+ * per measurement cycle instead of once per channel. Channels are taken
+ * from a devicetree io-channels list.
+ */
+
+#ifndef ANALOG_GROUP_H_
+#define ANALOG_GROUP_H_
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Channel group state.
+ */
+struct analog_group
+{
+    const struct adc_dt_spec* specs; /**< Channels, all on the same ADC */
+    size_t num;                      /**< Number of channels */
+
+    struct adc_sequence seq;
+    int16_t buf[CONFIG_ANALOG_WRAPPER_GROUP_MAX_CHANNELS];  /**< Results in channel-id order */
+    uint8_t slot[CONFIG_ANALOG_WRAPPER_GROUP_MAX_CHANNELS]; /**< Position of specs[i] in buf */
+};
+
+/** @cond INTERNAL_HIDDEN */
+#define ANALOG_GROUP_SPEC(node_id, prop, idx) ADC_DT_SPEC_GET_BY_IDX(node_id, idx),
+/** @endcond */
+
+/**
+ * @brief Define a group from the io-channels property of a node.
+ *
+ * @param name    Name of the struct analog_group variable
+ * @param node_id Devicetree node with an io-channels property
+ */
+#define ANALOG_GROUP_DT_DEFINE(name, node_id)                                                                                              \
+    static const struct adc_dt_spec name##_specs[] = {DT_FOREACH_PROP_ELEM(node_id, io_channels, ANALOG_GROUP_SPEC)};                      \
+    static struct analog_group name = {                                                                                                    \
+        .specs = name##_specs,                                                                                                             \
+        .num = ARRAY_SIZE(name##_specs),                                                                                                   \
+    }
+
+/**
+ * @brief Initialize a group.
+ *
+ * Sets up every channel and builds the shared sequence. All channels must
+ * be on the same ADC device and use the same resolution. Oversampling is
+ * only allowed for a single-channel group, since the nRF SAADC rejects it
+ * for a sequence with several channels.
+ *
+ * @param grp Group pointer, with specs and num set
+ *
+ * @retval 0 On success
+ * @retval -EINVAL Invalid arguments, mixed devices or settings, duplicate channels,
+ *                 oversampling on several channels
+ * @retval -ENODEV ADC device not ready
+ * @retval <other> ADC driver error code
+ */
+int analog_group_init(struct analog_group* grp);
+
+/**
+ * @brief Read all channels in one conversion burst.
+ *
+ * @param grp Group pointer
+ * @param raw Output, one raw value per channel in specs order
+ * @param num Size of @p raw, at least grp->num
+ *
+ * @retval 0 On success
+ * @retval -EINVAL Invalid arguments
+ * @retval <other> ADC driver error code
+ */
+int analog_group_read(struct analog_group* grp, int16_t* raw, size_t num);
+
+/**
+ * @brief Read all channels and convert to millivolts at the pins.
+ *
+ * @param grp Group pointer
+ * @param mv  Output, one value per channel in specs order
+ * @param num Size of @p mv, at least grp->num
+ *
+ * @retval 0 On success
+ * @retval -EINVAL Invalid arguments
+ * @retval <other> ADC driver error code
+ */
+int analog_group_read_mv(struct analog_group* grp, int32_t* mv, size_t num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
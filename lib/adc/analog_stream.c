@@ -0,0 +1,195 @@
+#include <string.h>
+
+#include "analog_stream.h"
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_DECLARE(analog_wrp, CONFIG_ANALOG_WRAPPER_LOG_LEVEL);
+
+/* Start a block read into the buffer that is not owned by the callback */
+static int analog_stream_arm(struct analog_stream* st)
+{
+    st->seq.buffer = st->bufs[st->filling];
+    k_poll_signal_reset(&st->signal);
+    return adc_read_async(st->adc_dt.dev, &st->seq, &st->signal);
+}
+
+static void analog_stream_thread(void* p1, void* p2, void* p3)
+{
+    struct analog_stream* st = p1;
+    /* analog_stream_start() armed the first read */
+    bool armed = true;
+
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (atomic_get(&st->running)) {
+        unsigned int signaled;
+        int result;
+
+        (void)k_poll(&st->event, 1, K_FOREVER);
+        st->event.state = K_POLL_STATE_NOT_READY;
+        k_poll_signal_check(&st->signal, &signaled, &result);
+
+        uint32_t t_done = k_cycle_get_32();
+
+        if (!signaled) {
+            continue;
+        }
+        armed = false;
+        if (!atomic_get(&st->running)) {
+            break;
+        }
+        if (result) {
+            LOG_ERR("stream read failed (%d)", result);
+            st->stats.errors++;
+            break;
+        }
+
+        uint8_t done = st->filling;
+
+        st->filling ^= 1;
+        st->seq.calibrate = false;
+
+        int ret = analog_stream_arm(st);
+        uint32_t gap = k_cycle_get_32() - t_done;
+
+        armed = ret == 0;
+
+        st->stats.gap_cycles_max = MAX(st->stats.gap_cycles_max, gap);
+        st->stats.blocks++;
+        st->cb(st, st->bufs[done], st->block_samples, st->user_data);
+
+        if (ret) {
+            LOG_ERR("could not re-arm stream |%d|", ret);
+            st->stats.errors++;
+            break;
+        }
+    }
+
+    /*
+     * A stop between the running check and the re-arm leaves a read in
+     * progress. Wait it out, so the driver is done with the buffer when
+     * analog_stream_stop() returns and its completion cannot be taken for
+     * the first block of a later start.
+     */
+    if (armed) {
+        (void)k_poll(&st->event, 1, K_FOREVER);
+        st->event.state = K_POLL_STATE_NOT_READY;
+    }
+
+    atomic_clear(&st->running);
+}
+
+int analog_stream_init(struct analog_stream* st, const struct adc_dt_spec* adc_dt, int16_t* buf_a, int16_t* buf_b, size_t block_samples,
+                       uint32_t interval_us, analog_stream_cb_t cb, void* user_data)
+{
+    if (!st || !adc_dt || !buf_a || !buf_b || buf_a == buf_b || !cb || block_samples == 0 || block_samples > UINT16_MAX + 1) {
+        return -EINVAL;
+    }
+
+    if (!adc_is_ready_dt(adc_dt)) {
+        LOG_ERR("ADC device %s is not ready", adc_dt->dev->name);
+        return -ENODEV;
+    }
+
+    memset(st, 0, sizeof(*st));
+    st->adc_dt = *adc_dt;
+
+    int retval = adc_channel_setup_dt(adc_dt);
+
+    if (0 != retval) {
+        LOG_ERR("could not configure analog input |%d|", retval);
+        return retval;
+    }
+
+    retval = adc_sequence_init_dt(adc_dt, &st->seq);
+    if (0 != retval) {
+        LOG_ERR("could not init sequence |%d|", retval);
+        return retval;
+    }
+
+    /* Samples are stored as int16_t */
+    if (st->seq.resolution > 16) {
+        return -EINVAL;
+    }
+
+    st->opts.interval_us = interval_us;
+    st->opts.extra_samplings = block_samples - 1;
+    st->opts.callback = NULL;
+    st->opts.user_data = NULL;
+    st->seq.options = &st->opts;
+    st->seq.buffer_size = block_samples * sizeof(int16_t);
+
+    st->bufs[0] = buf_a;
+    st->bufs[1] = buf_b;
+    st->block_samples = block_samples;
+    st->cb = cb;
+    st->user_data = user_data;
+
+    k_poll_signal_init(&st->signal);
+    k_poll_event_init(&st->event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &st->signal);
+
+    return 0;
+}
+
+int analog_stream_start(struct analog_stream* st, k_thread_stack_t* stack, size_t stack_size, int prio)
+{
+    if (!st || !stack || !stack_size || !st->cb) {
+        return -EINVAL;
+    }
+    if (!atomic_cas(&st->running, 0, 1)) {
+        return -EALREADY;
+    }
+
+    /* Reap a thread that stopped itself after an error */
+    if (st->started) {
+        k_thread_join(&st->thread, K_FOREVER);
+        st->started = false;
+    }
+
+    st->filling = 0;
+    st->seq.calibrate = true;
+
+    int ret = analog_stream_arm(st);
+
+    if (ret) {
+        LOG_ERR("could not start stream |%d|", ret);
+        atomic_clear(&st->running);
+        return ret;
+    }
+
+    k_thread_create(&st->thread, stack, stack_size, analog_stream_thread, st, NULL, NULL, prio, 0, K_NO_WAIT);
+    k_thread_name_set(&st->thread, "analog_stream");
+    st->started = true;
+
+    return 0;
+}
+
+int analog_stream_stop(struct analog_stream* st)
+{
+    if (!st) {
+        return -EINVAL;
+    }
+
+    if (!st->started) {
+        return 0;
+    }
+
+    /* The thread exits once the block in progress completes */
+    atomic_clear(&st->running);
+    k_thread_join(&st->thread, K_FOREVER);
+    st->started = false;
+
+    return 0;
+}
+
+int analog_stream_get_stats(struct analog_stream* st, struct analog_stream_stats* stats)
+{
+    if (!st || !stats) {
+        return -EINVAL;
+    }
+
+    *stats = st->stats;
+    return 0;
+}
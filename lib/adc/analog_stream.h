@@ -0,0 +1,142 @@
+/**
+ * @file analog_stream.h
+ * @brief Continuous block sampling on one ADC channel.
+ *
+ * Samples a channel at a fixed interval into two caller-provided buffers in
+ * turn. Each block is one adc_read_async() with extra_samplings, so the
+ * driver fills it without per-sample callbacks. When a block completes the
+ * stream thread starts the other buffer first and then hands the finished
+ * block to the callback, which may use it until it returns.
+ *
+ * The ADC API cannot chain buffers, so there is a short gap between blocks
+ * while the next read is armed. Its length is reported in the statistics.
+ */
+
+#ifndef ANALOG_STREAM_H_
+#define ANALOG_STREAM_H_
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct analog_stream;
+
+/**
+ * @brief Block callback type.
+ *
+ * Called from the stream thread for every completed block.
+ *
+ * @param st        Stream pointer
+ * @param block     Raw samples, valid until the callback returns
+ * @param samples   Number of samples in @p block
+ * @param user_data User-provided context
+ */
+typedef void (*analog_stream_cb_t)(struct analog_stream* st, const int16_t* block, size_t samples, void* user_data);
+
+/**
+ * @brief Stream statistics.
+ */
+struct analog_stream_stats
+{
+    uint32_t blocks;         /**< Blocks delivered */
+    uint32_t errors;         /**< Reads that failed; the stream stops on error */
+    uint32_t gap_cycles_max; /**< Longest time from waking on a finished block to arming the next */
+};
+
+/**
+ * @brief Stream state.
+ */
+struct analog_stream
+{
+    struct adc_dt_spec adc_dt; /**< ADC channel from devicetree */
+    struct adc_sequence seq;
+    struct adc_sequence_options opts;
+
+    int16_t* bufs[2];     /**< Ping-pong buffers */
+    size_t block_samples; /**< Samples per buffer */
+    uint8_t filling;      /**< Index of the buffer being filled */
+
+    analog_stream_cb_t cb; /**< Block callback */
+    void* user_data;       /**< User context */
+
+    struct k_poll_signal signal;
+    struct k_poll_event event;
+    struct k_thread thread;
+    bool started; /**< Thread was created and not joined yet */
+    atomic_t running;
+
+    struct analog_stream_stats stats;
+};
+
+/**
+ * @brief Initialize a stream.
+ *
+ * Configures the channel and a sequence of @p block_samples samplings
+ * @p interval_us apart. Oversampling and resolution come from devicetree.
+ *
+ * @param st            Stream pointer
+ * @param adc_dt        ADC channel specification
+ * @param buf_a         First block buffer
+ * @param buf_b         Second block buffer
+ * @param block_samples Samples per buffer, 1 to 65536
+ * @param interval_us   Sampling interval in microseconds
+ * @param cb            Block callback
+ * @param user_data     Passed back to @p cb
+ *
+ * @retval 0 On success
+ * @retval -EINVAL Invalid arguments
+ * @retval -ENODEV ADC device not ready
+ * @retval <other> ADC driver error code
+ */
+int analog_stream_init(struct analog_stream* st, const struct adc_dt_spec* adc_dt, int16_t* buf_a, int16_t* buf_b, size_t block_samples,
+                       uint32_t interval_us, analog_stream_cb_t cb, void* user_data);
+
+/**
+ * @brief Start streaming.
+ *
+ * @param st         Stream pointer
+ * @param stack      Stream thread stack
+ * @param stack_size Stack size
+ * @param prio       Stream thread priority
+ *
+ * @retval 0 On success
+ * @retval -EINVAL Invalid arguments
+ * @retval -EALREADY Stream is running
+ * @retval <other> Error from adc_read_async()
+ */
+int analog_stream_start(struct analog_stream* st, k_thread_stack_t* stack, size_t stack_size, int prio);
+
+/**
+ * @brief Stop streaming.
+ *
+ * Waits for the block in progress to complete, which takes up to one block
+ * period; that block is discarded.
+ *
+ * @param st Stream pointer
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If st is NULL
+ */
+int analog_stream_stop(struct analog_stream* st);
+
+/**
+ * @brief Get a snapshot of the stream statistics.
+ *
+ * @param st    Stream pointer
+ * @param stats Output
+ *
+ * @retval 0 On success
+ * @retval -EINVAL Invalid arguments
+ */
+int analog_stream_get_stats(struct analog_stream* st, struct analog_stream_stats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,11 +1,75 @@
 #include "analog_wrapper.h"
+#include <stdlib.h>
+#include <string.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/util.h>
 
-#include "dt_interfaces.h"
-
 LOG_MODULE_REGISTER(analog_wrp, CONFIG_ANALOG_WRAPPER_LOG_LEVEL);
 
+/* Only the optional battery divider is needed here, so resolve it locally
+ * instead of pulling in the application's board checks. */
+#define ANALOG_DIVIDER_NODE DT_PATH(voltage_divider)
+#define ANALOG_HAS_DIVIDER  DT_NODE_HAS_STATUS(ANALOG_DIVIDER_NODE, okay)
+
+/* Vbat = Vadc * (R1+R2) / R2, as a rounded Q16.16 factor */
+#if ANALOG_HAS_DIVIDER
+BUILD_ASSERT(DT_PROP(ANALOG_DIVIDER_NODE, output_ohms) != 0, "voltage-divider output-ohms must not be 0");
+
+#define ANALOG_DIVIDER_SCALE_Q16                                                                                                           \
+    ((uint32_t)((((uint64_t)DT_PROP(ANALOG_DIVIDER_NODE, full_ohms) << 16) + DT_PROP(ANALOG_DIVIDER_NODE, output_ohms) / 2) /              \
+                DT_PROP(ANALOG_DIVIDER_NODE, output_ohms)))
+#else
+#define ANALOG_DIVIDER_SCALE_Q16 (1U << 16)
+#endif
+
+/* input_positive value that leaves the channel unconnected (NC) */
+#define ANALOG_INPUT_DISCONNECTED 0
+
+#if CONFIG_ANALOG_WRAPPER_ASYNC
+static void analog_async_work_handler(struct k_work* work);
+#endif
+
+/* Take the context for one operation, so a read cannot start on top of another; false if taken */
+static bool analog_claim(struct analog_control_t* ctx)
+{
+#if CONFIG_ANALOG_WRAPPER_ASYNC
+    return atomic_cas(&ctx->async_busy, 0, 1);
+#else
+    ARG_UNUSED(ctx);
+    return true;
+#endif
+}
+
+static void analog_release(struct analog_control_t* ctx)
+{
+#if CONFIG_ANALOG_WRAPPER_ASYNC
+    atomic_clear(&ctx->async_busy);
+#else
+    ARG_UNUSED(ctx);
+#endif
+}
+
+static bool analog_calibration_due(const struct analog_control_t* ctx)
+{
+    if (ctx->calib_pending) {
+        return true;
+    }
+
+#if CONFIG_ANALOG_WRAPPER_CALIB_INTERVAL_S
+    if (k_uptime_get() - ctx->calib_time_ms >= (int64_t)CONFIG_ANALOG_WRAPPER_CALIB_INTERVAL_S * MSEC_PER_SEC) {
+        return true;
+    }
+#endif
+
+#if CONFIG_ANALOG_WRAPPER_CALIB_TEMP_DELTA
+    if (ctx->temp_valid && abs(ctx->temp_c - ctx->calib_temp_c) >= CONFIG_ANALOG_WRAPPER_CALIB_TEMP_DELTA) {
+        return true;
+    }
+#endif
+
+    return false;
+}
+
 int analog_init(struct analog_control_t* ctx, const struct adc_dt_spec* adc_dt)
 {
     if ((NULL == ctx) || (NULL == adc_dt)) {
@@ -49,15 +113,34 @@ int analog_init(struct analog_control_t* ctx, const struct adc_dt_spec* adc_dt)
     ctx->sequence_cfg.buffer_size = 0;
     ctx->sequence_cfg.calibrate = true;
 
-    ctx->voltage_divider_scale = 1.0;
+#if CONFIG_ANALOG_WRAPPER_OVERSAMPLING
+    ctx->sequence_cfg.oversampling = CONFIG_ANALOG_WRAPPER_OVERSAMPLING;
+#endif
 
-#if HAS_VOLTAGE_DIVIDER
-    uint32_t output_ohm = DT_PROP(VBATT_NODE, output_ohms);
-    uint32_t full_ohm = DT_PROP(VBATT_NODE, full_ohms);
+    // all samples of one reading in a single sequence, back to back
+    ctx->options.interval_us = 0;
+    ctx->options.extra_samplings = CONFIG_ANALOG_WRAPPER_SAMPLES - 1;
 
-    if (output_ohm != 0) {
-        ctx->voltage_divider_scale = (double)full_ohm / output_ohm;
-    }
+    ctx->divider_scale_q16 = ANALOG_DIVIDER_SCALE_Q16;
+
+    ctx->input_connected = true;
+    ctx->calib_pending = true;
+    ctx->calib_time_ms = 0;
+    ctx->calib_temp_c = 0;
+    ctx->temp_c = 0;
+    ctx->temp_valid = false;
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+
+#if CONFIG_ANALOG_WRAPPER_FILTER
+    analog_filter_init(&ctx->filter, ANALOG_FILTER_NONE, 0);
+#endif
+
+#if CONFIG_ANALOG_WRAPPER_ASYNC
+    k_poll_signal_init(&ctx->async_signal);
+    k_poll_event_init(&ctx->async_event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &ctx->async_signal);
+    k_work_poll_init(&ctx->async_work, analog_async_work_handler);
+    ctx->async_cb = NULL;
+    atomic_clear(&ctx->async_busy);
 #endif
 
     ctx->cached_voltage = 0;
@@ -73,6 +156,9 @@ int analog_deinit(struct analog_control_t* ctx)
     if (!ctx)
         return -EINVAL;
 
+    if (!analog_claim(ctx))
+        return -EBUSY;
+
     ctx->sequence_cfg.buffer = NULL;
     ctx->sequence_cfg.buffer_size = 0;
     ctx->cached_voltage = 0;
@@ -80,6 +166,8 @@ int analog_deinit(struct analog_control_t* ctx)
     ctx->cb_functions.post_measurement = NULL;
     ctx->cb_handle = NULL;
 
+    analog_release(ctx);
+
     return 0;
 }
 
@@ -101,62 +189,227 @@ int analog_register_callbacks(struct analog_control_t* ctx, const analog_callbac
     return 0;
 }
 
-int analog_read_raw(struct analog_control_t* ctx, int16_t* raw_val)
+/* Everything up to starting the conversion; shared by sync and async reads */
+static int analog_read_prepare(struct analog_control_t* ctx)
 {
-    if (!ctx || !raw_val)
-        return -EINVAL;
-
     if (ctx->cb_functions.pre_measurement) {
         ctx->cb_functions.pre_measurement(ctx->cb_handle);
     }
 
-    int retval = 0;
-
 #if CONFIG_ADC_CONFIGURABLE_INPUTS
 
-    // --- if there are configurable inputs, try to deactivate the ADC input pin
-    ctx->adc_dt.channel_cfg.input_positive = ctx->input_channel;
-    retval = adc_channel_setup_dt(&ctx->adc_dt);
+    // --- reconnect the ADC input pin only if it was deactivated
+    if (!ctx->input_connected) {
+        ctx->adc_dt.channel_cfg.input_positive = ctx->input_channel;
+        int retval = adc_channel_setup_dt(&ctx->adc_dt);
 
-    if (0 != retval) {
-        LOG_ERR("could not enable analog input");
+        if (0 != retval) {
+            LOG_ERR("could not enable analog input |%d|", retval);
+            return retval;
+        }
+
+        // no forced calibration: the offset calibration does not depend on the input mux
+        ctx->input_connected = true;
+        ctx->stats.reconfigs++;
     }
 
 #endif
 
+    ctx->sequence_cfg.calibrate = analog_calibration_due(ctx);
+
     ctx->options.callback = NULL;
     ctx->options.user_data = NULL;
 
-    ctx->sequence_cfg.buffer = &ctx->adc_value;
-    ctx->sequence_cfg.buffer_size = sizeof(ctx->adc_value);
+    ctx->sequence_cfg.buffer = ctx->samples;
+    ctx->sequence_cfg.buffer_size = sizeof(ctx->samples);
 
-    retval = adc_read(ctx->adc_dt.dev, &ctx->sequence_cfg);
-    if (retval) {
-        LOG_ERR("ADC read failed (%d)", retval);
-        return retval;
+    return 0;
+}
+
+/* Bookkeeping and averaging after a successful conversion */
+static int16_t analog_read_finish(struct analog_control_t* ctx)
+{
+    if (ctx->sequence_cfg.calibrate) {
+        ctx->calib_pending = false;
+        ctx->calib_time_ms = k_uptime_get();
+        ctx->calib_temp_c = ctx->temp_c;
+        ctx->stats.calibrations++;
     }
+    ctx->stats.reads++;
 
-    ctx->sequence_cfg.calibrate = false;  // recalibrate after enabling ADC input
+    const int32_t n = ARRAY_SIZE(ctx->samples);
+    int32_t sum = 0;
 
-    LOG_DBG("raw adc value: %d", ctx->adc_value);
+    for (int32_t i = 0; i < n; i++) {
+        sum += ctx->samples[i];
+    }
 
-    *raw_val = ctx->adc_value;
+    // rounded mean, symmetric around zero for differential inputs
+    ctx->adc_value = (sum >= 0 ? sum + n / 2 : sum - n / 2) / n;
+
+    LOG_DBG("raw adc value: %d", ctx->adc_value);
 
     if (ctx->cb_functions.post_measurement) {
         ctx->cb_functions.post_measurement(ctx->cb_handle);
     }
 
+    return ctx->adc_value;
+}
+
+int analog_read_raw(struct analog_control_t* ctx, int16_t* raw_val)
+{
+    if (!ctx || !raw_val)
+        return -EINVAL;
+
+    if (!analog_claim(ctx))
+        return -EBUSY;
+
+    int retval = analog_read_prepare(ctx);
+
+    if (retval == 0) {
+        retval = adc_read(ctx->adc_dt.dev, &ctx->sequence_cfg);
+        if (retval) {
+            LOG_ERR("ADC read failed (%d)", retval);
+        }
+        else {
+            *raw_val = analog_read_finish(ctx);
+        }
+    }
+
+    analog_release(ctx);
+
+    return retval;
+}
+
+#if CONFIG_ANALOG_WRAPPER_ASYNC
+static void analog_async_work_handler(struct k_work* work)
+{
+    struct k_work_poll* poll_work = CONTAINER_OF(work, struct k_work_poll, work);
+    struct analog_control_t* ctx = CONTAINER_OF(poll_work, struct analog_control_t, async_work);
+    unsigned int signaled;
+    int result;
+
+    k_poll_signal_check(&ctx->async_signal, &signaled, &result);
+
+    int16_t raw_val = 0;
+
+    if (!signaled) {
+        result = -EIO;
+    }
+    else if (result) {
+        LOG_ERR("ADC read failed (%d)", result);
+    }
+    else {
+        raw_val = analog_read_finish(ctx);
+    }
+
+    analog_read_done_f cb = ctx->async_cb;
+
+    /* Release before the callback so it can start the next read */
+    atomic_clear(&ctx->async_busy);
+
+    if (cb) {
+        cb(ctx, result, raw_val);
+    }
+}
+
+int analog_read_async(struct analog_control_t* ctx, analog_read_done_f cb)
+{
+    if (!ctx || !cb)
+        return -EINVAL;
+
+    if (!analog_claim(ctx))
+        return -EBUSY;
+
+    int retval = analog_read_prepare(ctx);
+
+    if (retval) {
+        atomic_clear(&ctx->async_busy);
+        return retval;
+    }
+
+    ctx->async_cb = cb;
+    k_poll_signal_reset(&ctx->async_signal);
+    ctx->async_event.state = K_POLL_STATE_NOT_READY;
+
+    retval = adc_read_async(ctx->adc_dt.dev, &ctx->sequence_cfg, &ctx->async_signal);
+    if (retval) {
+        LOG_ERR("ADC async read failed (%d)", retval);
+        atomic_clear(&ctx->async_busy);
+        return retval;
+    }
+
+    /* Completes on the system work queue, also if the conversion already finished */
+    retval = k_work_poll_submit(&ctx->async_work, &ctx->async_event, 1, K_FOREVER);
+    if (retval) {
+        LOG_ERR("could not queue ADC completion (%d)", retval);
+        /* The conversion still owns the sample buffer; wait it out before releasing */
+        k_poll(&ctx->async_event, 1, K_FOREVER);
+        atomic_clear(&ctx->async_busy);
+        return retval;
+    }
+
     return 0;
 }
+#endif
 
-int analog_read_voltage_mv(struct analog_control_t* ctx, int32_t* voltage_mv)
+#if CONFIG_ADC_CONFIGURABLE_INPUTS
+int analog_disconnect_input(struct analog_control_t* ctx)
 {
-    int16_t raw_adc;
-    int ret = analog_read_raw(ctx, &raw_adc);
-    if (ret)
-        return ret;
+    if (!ctx)
+        return -EINVAL;
+
+    if (!analog_claim(ctx))
+        return -EBUSY;
+
+    int retval = 0;
+
+    if (ctx->input_connected) {
+        ctx->adc_dt.channel_cfg.input_positive = ANALOG_INPUT_DISCONNECTED;
+        retval = adc_channel_setup_dt(&ctx->adc_dt);
+
+        if (0 != retval) {
+            LOG_ERR("could not disable analog input |%d|", retval);
+        }
+        else {
+            ctx->input_connected = false;
+        }
+    }
+
+    analog_release(ctx);
+
+    return retval;
+}
+#endif
+
+int analog_set_temperature(struct analog_control_t* ctx, int16_t temp_c)
+{
+    if (!ctx)
+        return -EINVAL;
+
+    if (!ctx->temp_valid) {
+        ctx->calib_temp_c = temp_c;
+        ctx->temp_valid = true;
+    }
+    ctx->temp_c = temp_c;
+
+    return 0;
+}
+
+int analog_get_stats(struct analog_control_t* ctx, struct analog_stats* stats)
+{
+    if (!ctx || !stats)
+        return -EINVAL;
+
+    *stats = ctx->stats;
+
+    return 0;
+}
 
+static int analog_raw_to_pin_mv(struct analog_control_t* ctx, int16_t raw_adc, int32_t* voltage_mv)
+{
     int32_t raw_val32 = raw_adc; /* promote to 32-bit */
+    int ret;
 
     ret = adc_raw_to_millivolts_dt(&ctx->adc_dt, &raw_val32);
     if (ret)
@@ -170,19 +423,68 @@ int analog_read_voltage_mv(struct analog_control_t* ctx, int32_t* voltage_mv)
     return 0;
 }
 
-int analog_read_battery_mv(struct analog_control_t* ctx, int32_t* battery_mv)
+int analog_read_voltage_mv(struct analog_control_t* ctx, int32_t* voltage_mv)
 {
+    int16_t raw_adc;
+    int ret = analog_read_raw(ctx, &raw_adc);
+    if (ret)
+        return ret;
+
+    return analog_raw_to_pin_mv(ctx, raw_adc, voltage_mv);
+}
+
+int analog_raw_to_battery_mv(struct analog_control_t* ctx, int16_t raw_val, int32_t* battery_mv)
+{
+    if (!ctx || !battery_mv)
+        return -EINVAL;
+
     int32_t v_adc_mv;
-    int ret = analog_read_voltage_mv(ctx, &v_adc_mv);
+    int ret = analog_raw_to_pin_mv(ctx, raw_val, &v_adc_mv);
     if (ret)
         return ret;
 
     /* Scale back using divider formula: Vbat = Vadc * (R1+R2) / R2 */
-    *battery_mv = v_adc_mv * ctx->voltage_divider_scale;
+    *battery_mv = (int32_t)(((int64_t)v_adc_mv * ctx->divider_scale_q16 + (1 << 15)) >> 16);
+
+    return 0;
+}
+
+int analog_filter_battery_mv(struct analog_control_t* ctx, int32_t* battery_mv)
+{
+    if (!ctx || !battery_mv)
+        return -EINVAL;
+
+#if CONFIG_ANALOG_WRAPPER_FILTER
+    *battery_mv = analog_filter_update(&ctx->filter, *battery_mv);
+#endif
 
     return 0;
 }
 
+int analog_read_battery_mv(struct analog_control_t* ctx, int32_t* battery_mv)
+{
+    int16_t raw_adc;
+    int ret = analog_read_raw(ctx, &raw_adc);
+    if (ret)
+        return ret;
+
+    ret = analog_raw_to_battery_mv(ctx, raw_adc, battery_mv);
+    if (ret)
+        return ret;
+
+    return analog_filter_battery_mv(ctx, battery_mv);
+}
+
+#if CONFIG_ANALOG_WRAPPER_FILTER
+int analog_set_filter(struct analog_control_t* ctx, enum analog_filter_type type, uint8_t param)
+{
+    if (!ctx)
+        return -EINVAL;
+
+    return analog_filter_init(&ctx->filter, type, param);
+}
+#endif
+
 int analog_get_battery_level(struct analog_control_t* ctx, int32_t min_mv, int32_t max_mv)
 {
     int32_t batt_mv;
@@ -190,6 +492,11 @@ int analog_get_battery_level(struct analog_control_t* ctx, int32_t min_mv, int32
     if (ret)
         return ret;
 
+    return analog_battery_level_from_mv(batt_mv, min_mv, max_mv);
+}
+
+int analog_battery_level_from_mv(int32_t batt_mv, int32_t min_mv, int32_t max_mv)
+{
     if (batt_mv <= min_mv)
         return 0;
     if (batt_mv >= max_mv)
@@ -12,6 +12,10 @@
 #include <zephyr/drivers/adc.h>
 #include <zephyr/kernel.h>
 
+#if CONFIG_ANALOG_WRAPPER_FILTER
+#include "analog_filter.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -37,6 +41,29 @@ typedef struct analog_callbacks
     analog_measurement_step_f post_measurement;
 } analog_callbacks_t;
 
+struct analog_control_t;
+
+/**
+ * @brief Completion callback of analog_read_async().
+ *
+ * Runs on the system work queue. A new read may be started from it.
+ *
+ * @param ctx     Pointer to analog control context
+ * @param result  0 on success, ADC driver error code otherwise
+ * @param raw_val Averaged raw value, valid if @p result is 0
+ */
+typedef void (*analog_read_done_f)(struct analog_control_t* ctx, int result, int16_t raw_val);
+
+/**
+ * @brief Counters of ADC work done by the wrapper.
+ */
+struct analog_stats
+{
+    uint32_t reads;        /**< Successful analog_read_raw() calls */
+    uint32_t reconfigs;    /**< Channel setups to reconnect the input */
+    uint32_t calibrations; /**< Reads that ran an offset calibration */
+};
+
 /**
  * @brief Control structure for ADC wrapper.
  *
@@ -48,14 +75,35 @@ struct analog_control_t
     struct adc_sequence sequence_cfg;
     struct adc_sequence_options options;  ///< configuration of the ADC sequence options
 
-    int32_t adc_value;       ///< last measured ADC value
-    int32_t cached_voltage;  ///< last measured voltage
+    int16_t samples[CONFIG_ANALOG_WRAPPER_SAMPLES];  ///< sample buffer of one reading
+    int32_t adc_value;                               ///< last measured ADC value, averaged over the samples
+    int32_t cached_voltage;                          ///< last measured voltage
 
-    double voltage_divider_scale;  ///< voltage divider scale factor
-    uint8_t input_channel;         ///< original channel id. Cached to allow deactivation of ADC channel for power saving reasons.
+    uint32_t divider_scale_q16;  ///< voltage divider scale factor in Q16.16
+    uint8_t input_channel;       ///< original channel id. Cached to allow deactivation of ADC channel for power saving reasons.
+    bool input_connected;        ///< channel is set up with input_channel, no setup needed before a read
+
+    bool calib_pending;         ///< calibrate on the next read
+    int64_t calib_time_ms;      ///< uptime of the last calibration
+    int16_t calib_temp_c;       ///< temperature at the last calibration
+    int16_t temp_c;             ///< last temperature from analog_set_temperature()
+    bool temp_valid;            ///< temp_c has been set
+    struct analog_stats stats;  ///< work counters
 
     analog_callbacks_t cb_functions;  ///< callback functions
     void* cb_handle;                  ///< user defined handle passed to the callback functions
+
+#if CONFIG_ANALOG_WRAPPER_FILTER
+    struct analog_filter filter;  ///< battery reading filter
+#endif
+
+#if CONFIG_ANALOG_WRAPPER_ASYNC
+    struct k_poll_signal async_signal;  ///< raised by the ADC driver when the conversion is done
+    struct k_poll_event async_event;    ///< event on async_signal
+    struct k_work_poll async_work;      ///< runs the completion on the system work queue
+    analog_read_done_f async_cb;        ///< completion callback of the pending read
+    atomic_t async_busy;                ///< a read or reconfiguration is in progress
+#endif
 };
 
 /**
@@ -78,6 +126,7 @@ int analog_init(struct analog_control_t* ctx, const struct adc_dt_spec* adc_dt);
  *
  * @retval 0 On success
  * @retval -EINVAL If ctx is NULL
+ * @retval -EBUSY Another read is in progress
  */
 int analog_deinit(struct analog_control_t* ctx);
 
@@ -96,17 +145,45 @@ int analog_register_callbacks(struct analog_control_t* ctx, const analog_callbac
 /**
  * @brief Read raw ADC value.
  *
- * Executes a synchronous ADC read and returns the raw sample value.
+ * Executes a synchronous ADC read of CONFIG_ANALOG_WRAPPER_SAMPLES samples
+ * and returns their rounded average. The channel is only set up again if
+ * the input was disconnected with analog_disconnect_input(). The ADC is
+ * calibrated on the first read and when the
+ * CONFIG_ANALOG_WRAPPER_CALIB_INTERVAL_S or
+ * CONFIG_ANALOG_WRAPPER_CALIB_TEMP_DELTA policy says so; reconnecting the
+ * input does not force a calibration.
  *
  * @param ctx     Pointer to analog control context
  * @param raw_val Pointer to store raw ADC value
  *
  * @retval 0 On success
  * @retval -EINVAL Invalid arguments
+ * @retval -EBUSY Another read is in progress
  * @retval <other> ADC driver error code
  */
 int analog_read_raw(struct analog_control_t* ctx, int16_t* raw_val);
 
+#if CONFIG_ANALOG_WRAPPER_ASYNC
+/**
+ * @brief Start a non-blocking raw read.
+ *
+ * Same measurement as analog_read_raw(), but returns once the conversion
+ * is started. The pre-measurement callback runs in the caller, the
+ * post-measurement callback and @p cb on the system work queue. Use
+ * analog_raw_to_battery_mv() and analog_filter_battery_mv() in @p cb to get
+ * the battery voltage.
+ *
+ * @param ctx Pointer to analog control context
+ * @param cb  Completion callback
+ *
+ * @retval 0 Conversion started, @p cb will be called
+ * @retval -EINVAL Invalid arguments
+ * @retval -EBUSY Another read is in progress
+ * @retval <other> ADC driver error code, @p cb will not be called
+ */
+int analog_read_async(struct analog_control_t* ctx, analog_read_done_f cb);
+#endif
+
 /**
  * @brief Read voltage at ADC pin (mV, after divider).
  *
@@ -120,11 +197,46 @@ int analog_read_raw(struct analog_control_t* ctx, int16_t* raw_val);
  */
 int analog_read_voltage_mv(struct analog_control_t* ctx, int32_t* voltage_mv);
 
+/**
+ * @brief Convert a raw value to battery voltage in mV.
+ *
+ * Pin voltage and divider scaling of analog_read_battery_mv() applied to a
+ * value from analog_read_raw() or analog_read_async(). The battery filter
+ * is not touched, so converting the same value twice gives the same result.
+ *
+ * @param ctx        Pointer to analog control context
+ * @param raw_val    Raw ADC value
+ * @param battery_mv Pointer to store battery voltage in millivolts
+ *
+ * @retval 0 On success
+ * @retval -EINVAL Invalid arguments
+ * @retval <other> Error code from adc_raw_to_millivolts_dt()
+ */
+int analog_raw_to_battery_mv(struct analog_control_t* ctx, int16_t raw_val, int32_t* battery_mv);
+
+/**
+ * @brief Feed a battery voltage to the battery filter.
+ *
+ * analog_read_battery_mv() does this for every reading. Call it once per
+ * reading in an analog_read_async() callback, on the result of
+ * analog_raw_to_battery_mv(). Without CONFIG_ANALOG_WRAPPER_FILTER the
+ * value is left as is.
+ *
+ * @param ctx        Pointer to analog control context
+ * @param battery_mv Battery voltage in millivolts, replaced by the filtered value
+ *
+ * @retval 0 On success
+ * @retval -EINVAL Invalid arguments
+ */
+int analog_filter_battery_mv(struct analog_control_t* ctx, int32_t* battery_mv);
+
 /**
  * @brief Read battery voltage in mV (corrected for divider).
  *
  * Applies configured voltage divider scaling to reconstruct
- * the original battery voltage.
+ * the original battery voltage. The scale is a Q16.16 factor computed
+ * at build time from the voltage-divider node, and the result is passed
+ * through the filter set with analog_set_filter(), if any.
  *
  * @param ctx        Pointer to analog control context
  * @param battery_mv Pointer to store battery voltage in millivolts
@@ -134,6 +246,66 @@ int analog_read_voltage_mv(struct analog_control_t* ctx, int32_t* voltage_mv);
  */
 int analog_read_battery_mv(struct analog_control_t* ctx, int32_t* battery_mv);
 
+#if CONFIG_ADC_CONFIGURABLE_INPUTS
+/**
+ * @brief Disconnect the ADC input pin to save power.
+ *
+ * The next read reconnects the input. It only calibrates if the
+ * calibration policy is due anyway.
+ *
+ * @param ctx Pointer to analog control context
+ *
+ * @retval 0 On success, or if already disconnected
+ * @retval -EINVAL If ctx is NULL
+ * @retval -EBUSY Another read is in progress
+ * @retval <other> ADC driver error code
+ */
+int analog_disconnect_input(struct analog_control_t* ctx);
+#endif
+
+/**
+ * @brief Report the current temperature for the calibration policy.
+ *
+ * The first report sets the reference; later reads calibrate once the
+ * temperature has moved CONFIG_ANALOG_WRAPPER_CALIB_TEMP_DELTA from the
+ * temperature at the last calibration.
+ *
+ * @param ctx    Pointer to analog control context
+ * @param temp_c Temperature in degrees Celsius, e.g. from the die sensor
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If ctx is NULL
+ */
+int analog_set_temperature(struct analog_control_t* ctx, int16_t temp_c);
+
+/**
+ * @brief Get the reconfiguration and calibration counters.
+ *
+ * @param ctx   Pointer to analog control context
+ * @param stats Output
+ *
+ * @retval 0 On success
+ * @retval -EINVAL Invalid arguments
+ */
+int analog_get_stats(struct analog_control_t* ctx, struct analog_stats* stats);
+
+#if CONFIG_ANALOG_WRAPPER_FILTER
+/**
+ * @brief Set the battery reading filter.
+ *
+ * Replaces the current filter and drops its history. The filter starts
+ * as ANALOG_FILTER_NONE after analog_init().
+ *
+ * @param ctx   Pointer to analog control context
+ * @param type  Filter type
+ * @param param Window length or IIR shift, see analog_filter_init()
+ *
+ * @retval 0 On success
+ * @retval -EINVAL Invalid arguments
+ */
+int analog_set_filter(struct analog_control_t* ctx, enum analog_filter_type type, uint8_t param);
+#endif
+
 /**
  * @brief Estimate battery level percentage.
  *
@@ -149,6 +321,17 @@ int analog_read_battery_mv(struct analog_control_t* ctx, int32_t* battery_mv);
  */
 int analog_get_battery_level(struct analog_control_t* ctx, int32_t min_mv, int32_t max_mv);
 
+/**
+ * @brief Map a battery voltage to a percentage.
+ *
+ * @param batt_mv Battery voltage in millivolts
+ * @param min_mv  Voltage considered as 0% (empty)
+ * @param max_mv  Voltage considered as 100% (full)
+ *
+ * @return Battery level percentage [0–100]
+ */
+int analog_battery_level_from_mv(int32_t batt_mv, int32_t min_mv, int32_t max_mv);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "i2c_arbiter.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(i2cw, CONFIG_I2C_LOG_LEVEL);
+
+/* Account a grant. Caller holds bus->lock. */
+static void arb_account(struct i2cw_bus* bus, uint8_t prio, uint32_t wait)
+{
+    bus->stats.grants[prio]++;
+    if (wait) {
+        bus->stats.contended[prio]++;
+        bus->stats.wait_cycles[prio] += wait;
+        bus->stats.wait_cycles_max[prio] = MAX(bus->stats.wait_cycles_max[prio], wait);
+    }
+}
+
+int i2cw_bus_init(struct i2cw_bus* bus, const struct device* dev, size_t budget)
+{
+    if (!bus || !dev) {
+        return -EINVAL;
+    }
+
+    memset(bus, 0, sizeof(*bus));
+    bus->dev = dev;
+    bus->budget = budget;
+    for (size_t i = 0; i < I2CW_PRIO_COUNT; i++) {
+        sys_slist_init(&bus->waiters[i]);
+    }
+
+    return 0;
+}
+
+/* Take the bus if free, else queue @p waiter. Returns true if taken. */
+static bool arb_try_or_queue(struct i2cw_bus* bus, struct i2cw_bus_waiter* waiter, enum i2cw_prio prio)
+{
+    k_spinlock_key_t key = k_spin_lock(&bus->lock);
+
+    if (!bus->owned) {
+        bus->owned = true;
+        arb_account(bus, prio, 0);
+        k_spin_unlock(&bus->lock, key);
+        return true;
+    }
+
+    waiter->prio = prio;
+    waiter->granted = false;
+    waiter->t_enq = k_cycle_get_32();
+    sys_slist_append(&bus->waiters[prio], &waiter->node);
+    k_spin_unlock(&bus->lock, key);
+    return false;
+}
+
+int i2cw_bus_acquire(struct i2cw_bus* bus, enum i2cw_prio prio, k_timeout_t timeout)
+{
+    struct i2cw_bus_waiter waiter = {.grant_cb = NULL};
+
+    if (prio >= I2CW_PRIO_COUNT) {
+        return -EINVAL;
+    }
+
+    k_sem_init(&waiter.sem, 0, 1);
+    if (arb_try_or_queue(bus, &waiter, prio)) {
+        return 0;
+    }
+
+    if (k_sem_take(&waiter.sem, timeout) == 0) {
+        return 0;
+    }
+
+    /* Timed out, unless the grant raced with the timeout. The releaser is done with the waiter by then. */
+    return i2cw_bus_cancel(bus, &waiter) == -EALREADY ? 0 : -EAGAIN;
+}
+
+int i2cw_bus_acquire_async(struct i2cw_bus* bus, struct i2cw_bus_waiter* waiter, enum i2cw_prio prio, i2cw_bus_grant_t grant_cb)
+{
+    if (prio >= I2CW_PRIO_COUNT || !grant_cb) {
+        return -EINVAL;
+    }
+
+    waiter->grant_cb = grant_cb;
+    return arb_try_or_queue(bus, waiter, prio) ? 0 : -EINPROGRESS;
+}
+
+int i2cw_bus_cancel(struct i2cw_bus* bus, struct i2cw_bus_waiter* waiter)
+{
+    k_spinlock_key_t key = k_spin_lock(&bus->lock);
+
+    if (waiter->granted) {
+        k_spin_unlock(&bus->lock, key);
+        return -EALREADY;
+    }
+    (void)sys_slist_find_and_remove(&bus->waiters[waiter->prio], &waiter->node);
+    k_spin_unlock(&bus->lock, key);
+
+    return 0;
+}
+
+void i2cw_bus_release(struct i2cw_bus* bus)
+{
+    struct i2cw_bus_waiter* next = NULL;
+    i2cw_bus_grant_t grant_cb = NULL;
+
+    k_spinlock_key_t key = k_spin_lock(&bus->lock);
+
+    for (size_t i = 0; i < I2CW_PRIO_COUNT; i++) {
+        sys_snode_t* node = sys_slist_get(&bus->waiters[i]);
+
+        if (node) {
+            next = CONTAINER_OF(node, struct i2cw_bus_waiter, node);
+            break;
+        }
+    }
+
+    if (next) {
+        /* Hand over without dropping ownership, so nobody can barge in */
+        next->granted = true;
+        arb_account(bus, next->prio, MAX(k_cycle_get_32() - next->t_enq, 1U));
+        /*
+         * A blocking waiter lives on its owner's stack. Give the semaphore
+         * before the lock drops: once i2cw_bus_cancel() sees the grant the
+         * waiter may return, and nothing may touch it afterwards.
+         */
+        grant_cb = next->grant_cb;
+        if (!grant_cb) {
+            k_sem_give(&next->sem);
+        }
+    }
+    else {
+        bus->owned = false;
+    }
+
+    k_spin_unlock(&bus->lock, key);
+
+    if (grant_cb) {
+        grant_cb(next);
+    }
+}
+
+void i2cw_bus_count_chunk(struct i2cw_bus* bus)
+{
+    k_spinlock_key_t key = k_spin_lock(&bus->lock);
+    bus->stats.chunks++;
+    k_spin_unlock(&bus->lock, key);
+}
+
+void i2cw_bus_get_stats(struct i2cw_bus* bus, struct i2cw_bus_stats* stats)
+{
+    k_spinlock_key_t key = k_spin_lock(&bus->lock);
+    *stats = bus->stats;
+    k_spin_unlock(&bus->lock, key);
+}
+
+void i2cw_bus_reset_stats(struct i2cw_bus* bus)
+{
+    k_spinlock_key_t key = k_spin_lock(&bus->lock);
+    memset(&bus->stats, 0, sizeof(bus->stats));
+    k_spin_unlock(&bus->lock, key);
+}
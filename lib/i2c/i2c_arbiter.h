@@ -0,0 +1,141 @@
+/**
+ * @file i2c_arbiter.h
+ * @brief Per-bus arbitration between I2C wrapper contexts.
+ *
+ * All contexts sharing one bus device attach to one struct i2cw_bus. Every
+ * blocking call and every queued asynchronous transaction acquires the bus
+ * for one transaction and releases it afterwards. On release the bus is
+ * handed to the oldest waiter of the highest priority class, so
+ * high-priority traffic gets in at the next transaction boundary. Burst
+ * writes longer than the bus budget are split into several transactions.
+ */
+
+#ifndef I2C_ARBITER_H_
+#define I2C_ARBITER_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Priority classes, I2CW_PRIO_HIGH is served first.
+ */
+enum i2cw_prio {
+    I2CW_PRIO_HIGH,   /**< Time-critical, e.g. RTC alarm servicing */
+    I2CW_PRIO_NORMAL, /**< Default */
+    I2CW_PRIO_LOW,    /**< Bulk, e.g. codec coefficient uploads */
+    I2CW_PRIO_COUNT,
+};
+
+struct i2cw_bus_waiter;
+
+/**
+ * @brief Grant callback for asynchronous waiters.
+ *
+ * Runs in the context that released the bus; the waiter owns the bus when
+ * it is called.
+ */
+typedef void (*i2cw_bus_grant_t)(struct i2cw_bus_waiter* waiter);
+
+/**
+ * @brief Bus waiter.
+ */
+struct i2cw_bus_waiter
+{
+    sys_snode_t node;          /**< Entry in the priority list */
+    struct k_sem sem;          /**< Given on grant, blocking waiters only */
+    i2cw_bus_grant_t grant_cb; /**< Called on grant, asynchronous waiters only */
+    uint32_t t_enq;            /**< Cycle count when the wait started */
+    uint8_t prio;              /**< Priority class */
+    bool granted;              /**< Bus handed over */
+};
+
+/**
+ * @brief Wait statistics.
+ */
+struct i2cw_bus_stats
+{
+    uint32_t grants[I2CW_PRIO_COUNT];          /**< Acquisitions per class */
+    uint32_t contended[I2CW_PRIO_COUNT];       /**< Acquisitions that had to wait */
+    uint64_t wait_cycles[I2CW_PRIO_COUNT];     /**< Total cycles spent waiting */
+    uint32_t wait_cycles_max[I2CW_PRIO_COUNT]; /**< Longest single wait */
+    uint32_t chunks;                           /**< Extra transactions from budget splitting */
+};
+
+/**
+ * @brief Shared bus state.
+ */
+struct i2cw_bus
+{
+    const struct device* dev;             /**< Bus device */
+    size_t budget;                        /**< Max payload bytes per transaction, 0 for no limit */
+    bool owned;                           /**< Bus currently granted */
+    sys_slist_t waiters[I2CW_PRIO_COUNT]; /**< Waiters per class, FIFO */
+    struct i2cw_bus_stats stats;          /**< Wait statistics */
+    struct k_spinlock lock;               /**< Protects the fields above */
+};
+
+/**
+ * @brief Initialize a bus arbiter.
+ *
+ * @param bus    Arbiter
+ * @param dev    Bus device
+ * @param budget Max payload bytes per transaction before splitting, 0 for no limit
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If arguments invalid
+ */
+int i2cw_bus_init(struct i2cw_bus* bus, const struct device* dev, size_t budget);
+
+/**
+ * @brief Acquire the bus from a thread.
+ *
+ * @retval 0 On success
+ * @retval -EAGAIN If @p timeout expired
+ */
+int i2cw_bus_acquire(struct i2cw_bus* bus, enum i2cw_prio prio, k_timeout_t timeout);
+
+/**
+ * @brief Acquire the bus without blocking.
+ *
+ * @retval 0 If the bus was free and is now owned by the caller
+ * @retval -EINPROGRESS If @p waiter was queued; @p grant_cb runs once the bus is handed over
+ */
+int i2cw_bus_acquire_async(struct i2cw_bus* bus, struct i2cw_bus_waiter* waiter, enum i2cw_prio prio, i2cw_bus_grant_t grant_cb);
+
+/**
+ * @brief Remove a queued asynchronous waiter.
+ *
+ * @retval 0 If the waiter was removed
+ * @retval -EALREADY If the bus was already granted to it
+ */
+int i2cw_bus_cancel(struct i2cw_bus* bus, struct i2cw_bus_waiter* waiter);
+
+/**
+ * @brief Release the bus, handing it to the next waiter if any.
+ */
+void i2cw_bus_release(struct i2cw_bus* bus);
+
+/**
+ * @brief Count one extra transaction from splitting a burst at the budget.
+ */
+void i2cw_bus_count_chunk(struct i2cw_bus* bus);
+
+/**
+ * @brief Copy the wait statistics.
+ */
+void i2cw_bus_get_stats(struct i2cw_bus* bus, struct i2cw_bus_stats* stats);
+
+/**
+ * @brief Clear the wait statistics.
+ */
+void i2cw_bus_reset_stats(struct i2cw_bus* bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // I2C_ARBITER_H_
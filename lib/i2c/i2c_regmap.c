@@ -0,0 +1,268 @@
+#include "i2c_regmap.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(i2cw, CONFIG_I2C_LOG_LEVEL);
+
+static inline bool regmap_test(const uint32_t* bits, size_t idx)
+{
+    return bits[idx / 32] & BIT(idx % 32);
+}
+
+static inline void regmap_set(uint32_t* bits, size_t idx, bool on)
+{
+    if (on) {
+        bits[idx / 32] |= BIT(idx % 32);
+    }
+    else {
+        bits[idx / 32] &= ~BIT(idx % 32);
+    }
+}
+
+static int regmap_find(const struct i2cw_regmap* map, uint8_t reg)
+{
+    size_t lo = 0;
+    size_t hi = map->num_regs;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (map->regs[mid].addr == reg) {
+            return (int)mid;
+        }
+        if (map->regs[mid].addr < reg) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return -ENOENT;
+}
+
+static size_t regmap_put(uint8_t* dst, uint32_t val, uint8_t width)
+{
+    for (uint8_t i = 0; i < width; i++) {
+        dst[i] = (uint8_t)(val >> (8 * (width - 1 - i)));
+    }
+    return width;
+}
+
+static int regmap_bus_read(struct i2cw_regmap* map, const struct i2cw_reg_desc* desc, uint32_t* val)
+{
+    uint8_t buf[4];
+
+    map->bus_reads++;
+    int ret = i2cw_write_read(map->i2c, &desc->addr, 1, buf, desc->width);
+    if (ret) {
+        return ret;
+    }
+
+    *val = 0;
+    for (uint8_t i = 0; i < desc->width; i++) {
+        *val = (*val << 8) | buf[i];
+    }
+    return 0;
+}
+
+static int regmap_bus_write(struct i2cw_regmap* map, const struct i2cw_reg_desc* desc, uint32_t val)
+{
+    uint8_t buf[1 + 4];
+
+    buf[0] = desc->addr;
+    map->bus_writes++;
+    return i2cw_write(map->i2c, buf, 1 + regmap_put(&buf[1], val, desc->width));
+}
+
+/* Write one value. Caller holds map->lock. */
+static int regmap_write_locked(struct i2cw_regmap* map, int idx, uint32_t val)
+{
+    const struct i2cw_reg_desc* desc = &map->regs[idx];
+
+    if (desc->is_volatile) {
+        return map->cache_only ? -EPERM : regmap_bus_write(map, desc, val);
+    }
+
+    if (map->cache[idx] == val && !regmap_test(map->dirty, idx)) {
+        map->writes_skipped++;
+        return 0;
+    }
+
+    map->cache[idx] = val;
+    if (map->cache_only) {
+        regmap_set(map->dirty, idx, true);
+        return 0;
+    }
+
+    int ret = regmap_bus_write(map, desc, val);
+    regmap_set(map->dirty, idx, ret != 0);
+    return ret;
+}
+
+int i2cw_regmap_init(struct i2cw_regmap* map, struct i2c_ctx* i2c)
+{
+    if (!map || !i2c || !map->regs || !map->cache || !map->dirty) {
+        return -EINVAL;
+    }
+
+    for (size_t i = 0; i < map->num_regs; i++) {
+        const struct i2cw_reg_desc* desc = &map->regs[i];
+
+        if (desc->width == 0 || desc->width > 4 || (i && desc->addr <= map->regs[i - 1].addr)) {
+            LOG_ERR("Bad register table entry %u", (unsigned)i);
+            return -EINVAL;
+        }
+        map->cache[i] = desc->def;
+    }
+
+    memset(map->dirty, 0, DIV_ROUND_UP(map->num_regs, 32) * sizeof(uint32_t));
+    map->i2c = i2c;
+    map->cache_only = false;
+    map->cache_hits = 0;
+    map->writes_skipped = 0;
+    map->bus_reads = 0;
+    map->bus_writes = 0;
+    k_mutex_init(&map->lock);
+
+    return 0;
+}
+
+int i2cw_regmap_read(struct i2cw_regmap* map, uint8_t reg, uint32_t* val)
+{
+    if (!map || !val) {
+        return -EINVAL;
+    }
+
+    int idx = regmap_find(map, reg);
+    if (idx < 0) {
+        return idx;
+    }
+
+    int ret = 0;
+
+    k_mutex_lock(&map->lock, K_FOREVER);
+    if (map->regs[idx].is_volatile) {
+        ret = regmap_bus_read(map, &map->regs[idx], val);
+    }
+    else {
+        map->cache_hits++;
+        *val = map->cache[idx];
+    }
+    k_mutex_unlock(&map->lock);
+
+    return ret;
+}
+
+int i2cw_regmap_write(struct i2cw_regmap* map, uint8_t reg, uint32_t val)
+{
+    if (!map) {
+        return -EINVAL;
+    }
+
+    int idx = regmap_find(map, reg);
+    if (idx < 0) {
+        return idx;
+    }
+
+    k_mutex_lock(&map->lock, K_FOREVER);
+    int ret = regmap_write_locked(map, idx, val);
+    k_mutex_unlock(&map->lock);
+
+    return ret;
+}
+
+int i2cw_regmap_update_bits(struct i2cw_regmap* map, uint8_t reg, uint32_t mask, uint32_t val)
+{
+    if (!map) {
+        return -EINVAL;
+    }
+
+    int idx = regmap_find(map, reg);
+    if (idx < 0) {
+        return idx;
+    }
+
+    uint32_t cur;
+    int ret = 0;
+
+    k_mutex_lock(&map->lock, K_FOREVER);
+    if (map->regs[idx].is_volatile) {
+        ret = regmap_bus_read(map, &map->regs[idx], &cur);
+    }
+    else {
+        map->cache_hits++;
+        cur = map->cache[idx];
+    }
+    if (ret == 0) {
+        ret = regmap_write_locked(map, idx, (cur & ~mask) | (val & mask));
+    }
+    k_mutex_unlock(&map->lock);
+
+    return ret;
+}
+
+void i2cw_regmap_cache_only(struct i2cw_regmap* map, bool enable)
+{
+    k_mutex_lock(&map->lock, K_FOREVER);
+    map->cache_only = enable;
+    k_mutex_unlock(&map->lock);
+}
+
+int i2cw_regmap_sync(struct i2cw_regmap* map)
+{
+    uint8_t buf[1 + CONFIG_I2C_WRAPPER_REGMAP_BURST_MAX];
+    int ret = 0;
+
+    if (!map) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&map->lock, K_FOREVER);
+
+    size_t i = 0;
+    while (i < map->num_regs && ret == 0) {
+        if (!regmap_test(map->dirty, i)) {
+            i++;
+            continue;
+        }
+
+        /* Extend the burst over dirty registers at consecutive addresses */
+        size_t first = i;
+        size_t len = 1;
+
+        buf[0] = map->regs[i].addr;
+        do {
+            len += regmap_put(&buf[len], map->cache[i], map->regs[i].width);
+            i++;
+        } while (i < map->num_regs && regmap_test(map->dirty, i) && map->regs[i].addr == map->regs[i - 1].addr + 1 &&
+                 len + map->regs[i].width <= sizeof(buf));
+
+        map->bus_writes++;
+        ret = i2cw_write(map->i2c, buf, len);
+        if (ret == 0) {
+            for (size_t j = first; j < i; j++) {
+                regmap_set(map->dirty, j, false);
+            }
+        }
+    }
+
+    k_mutex_unlock(&map->lock);
+
+    if (ret) {
+        LOG_ERR("Register sync failed (%d)", ret);
+    }
+    return ret;
+}
+
+void i2cw_regmap_mark_dirty(struct i2cw_regmap* map)
+{
+    k_mutex_lock(&map->lock, K_FOREVER);
+    for (size_t i = 0; i < map->num_regs; i++) {
+        if (!map->regs[i].is_volatile && map->cache[i] != map->regs[i].def) {
+            regmap_set(map->dirty, i, true);
+        }
+    }
+    k_mutex_unlock(&map->lock);
+}
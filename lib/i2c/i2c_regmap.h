@@ -0,0 +1,142 @@
+/**
+ * @file i2c_regmap.h
+ * @brief Register-map cache on top of the I2C wrapper.
+ *
+ * A device is described by a compile-time table of registers. Reads of
+ * non-volatile registers are served from RAM and read-modify-write updates
+ * cost at most one bus write. In cache-only mode writes are only recorded,
+ * and i2cw_regmap_sync() flushes them in address-contiguous bursts.
+ *
+ * Registers use 8-bit addresses and big-endian values of 1 to 4 bytes; the
+ * device is expected to auto-increment the register address by one per
+ * register during a burst.
+ */
+
+#ifndef I2C_REGMAP_H_
+#define I2C_REGMAP_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "i2c_wrapper.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Register description.
+ */
+struct i2cw_reg_desc
+{
+    uint8_t addr;     /**< Register address */
+    uint8_t width;    /**< Value width in bytes, 1..4 */
+    bool is_volatile; /**< Value can change behind our back, never cached */
+    uint32_t def;     /**< Value after device reset */
+};
+
+/** @brief Table entry helper. */
+#define I2CW_REG(_addr, _width, _volatile, _def) {.addr = (_addr), .width = (_width), .is_volatile = (_volatile), .def = (_def)}
+
+/**
+ * @brief Register map.
+ */
+struct i2cw_regmap
+{
+    struct i2c_ctx* i2c;              /**< Bus context */
+    const struct i2cw_reg_desc* regs; /**< Register table, sorted by address */
+    size_t num_regs;                  /**< Table entries */
+    uint32_t* cache;                  /**< Cached value per register */
+    uint32_t* dirty;                  /**< Bitmap of cached values not yet written */
+    bool cache_only;                  /**< Record writes without touching the bus */
+    struct k_mutex lock;              /**< Serializes cache and bus access */
+
+    uint32_t cache_hits;     /**< Reads served from RAM */
+    uint32_t writes_skipped; /**< Writes dropped because the value was unchanged */
+    uint32_t bus_reads;      /**< Read transactions issued */
+    uint32_t bus_writes;     /**< Write transactions issued */
+};
+
+/**
+ * @brief Statically define a register map and its cache for @p table.
+ *
+ * @param name  Name of the struct i2cw_regmap variable.
+ * @param table Array of struct i2cw_reg_desc, sorted by address.
+ */
+#define I2CW_REGMAP_DEFINE(name, table)                                        \
+    static uint32_t name##_cache[ARRAY_SIZE(table)];                           \
+    static uint32_t name##_dirty[DIV_ROUND_UP(ARRAY_SIZE(table), 32)];         \
+    static struct i2cw_regmap name = {                                         \
+        .regs = (table),                                                       \
+        .num_regs = ARRAY_SIZE(table),                                         \
+        .cache = name##_cache,                                                 \
+        .dirty = name##_dirty,                                                 \
+    }
+
+/**
+ * @brief Bind a register map to a bus context and load the reset defaults.
+ *
+ * @param map Register map.
+ * @param i2c Initialized I2C wrapper context addressing the device.
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If arguments are invalid or the table is not sorted
+ */
+int i2cw_regmap_init(struct i2cw_regmap* map, struct i2c_ctx* i2c);
+
+/**
+ * @brief Read a register, from the cache unless it is volatile.
+ *
+ * @retval 0 On success
+ * @retval -ENOENT If @p reg is not in the table
+ * @retval <0 Bus error
+ */
+int i2cw_regmap_read(struct i2cw_regmap* map, uint8_t reg, uint32_t* val);
+
+/**
+ * @brief Write a register.
+ *
+ * Unchanged non-volatile values are not written. In cache-only mode the
+ * value is only recorded for the next i2cw_regmap_sync().
+ *
+ * @retval 0 On success
+ * @retval -ENOENT If @p reg is not in the table
+ * @retval -EPERM If @p reg is volatile and the map is cache-only
+ * @retval <0 Bus error
+ */
+int i2cw_regmap_write(struct i2cw_regmap* map, uint8_t reg, uint32_t val);
+
+/**
+ * @brief Read-modify-write the bits selected by @p mask.
+ *
+ * @retval 0 On success
+ * @retval <0 As i2cw_regmap_read() and i2cw_regmap_write()
+ */
+int i2cw_regmap_update_bits(struct i2cw_regmap* map, uint8_t reg, uint32_t mask, uint32_t val);
+
+/**
+ * @brief Enable or disable cache-only mode.
+ *
+ * Leaving cache-only mode does not flush; call i2cw_regmap_sync().
+ */
+void i2cw_regmap_cache_only(struct i2cw_regmap* map, bool enable);
+
+/**
+ * @brief Write all dirty registers, merging neighbours into burst writes.
+ *
+ * @retval 0 On success
+ * @retval <0 Bus error, registers not yet written stay dirty
+ */
+int i2cw_regmap_sync(struct i2cw_regmap* map);
+
+/**
+ * @brief Mark every non-volatile register whose cached value differs from
+ * its default as dirty, e.g. after the device lost power.
+ */
+void i2cw_regmap_mark_dirty(struct i2cw_regmap* map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // I2C_REGMAP_H_
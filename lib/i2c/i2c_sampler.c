@@ -0,0 +1,178 @@
+#include "i2c_sampler.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(i2cw, CONFIG_I2C_LOG_LEVEL);
+
+static void sampler_schedule(struct i2cw_sampler* smp, k_timeout_t delay)
+{
+    if (smp->workq) {
+        (void)k_work_reschedule_for_queue(smp->workq, &smp->work, delay);
+    }
+    else {
+        (void)k_work_reschedule(&smp->work, delay);
+    }
+}
+
+static void sampler_slot_done(void* user_data, int result, uint8_t* buf, size_t len)
+{
+    struct i2cw_sample_slot* slot = user_data;
+
+    slot->samples++;
+    if (slot->cb) {
+        slot->cb(slot->user_data, result, buf, len);
+    }
+    atomic_clear(&slot->busy);
+}
+
+/* Queue one read. Returns false if the slot has to skip this sample. */
+static bool sampler_slot_submit(struct i2cw_sample_slot* slot)
+{
+    if (atomic_set(&slot->busy, 1)) {
+        return false;
+    }
+
+    const struct i2c_msg msgs[2] = {
+        {.buf = &slot->reg, .len = 1, .flags = I2C_MSG_WRITE},
+        {.buf = slot->buf, .len = slot->len, .flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP},
+    };
+
+    if (i2cw_submit(slot->i2c, slot->addr, msgs, ARRAY_SIZE(msgs), sampler_slot_done, slot)) {
+        atomic_clear(&slot->busy);
+        return false;
+    }
+    return true;
+}
+
+static void sampler_work_handler(struct k_work* work)
+{
+    struct k_work_delayable* dwork = k_work_delayable_from_work(work);
+    struct i2cw_sampler* smp = CONTAINER_OF(dwork, struct i2cw_sampler, work);
+
+    k_mutex_lock(&smp->lock, K_FOREVER);
+
+    if (!smp->running) {
+        k_mutex_unlock(&smp->lock);
+        return;
+    }
+
+    int64_t now = k_uptime_get();
+    int64_t horizon = now + CONFIG_I2C_WRAPPER_SAMPLER_WINDOW_MS;
+    int64_t next = INT64_MAX;
+
+    smp->wakeups++;
+
+    for (size_t i = 0; i < smp->num_slots; i++) {
+        struct i2cw_sample_slot* slot = &smp->slots[i];
+
+        if (slot->next_due <= horizon) {
+            if (!sampler_slot_submit(slot)) {
+                slot->overruns++;
+            }
+
+            /* Advance on the fixed grid; skip whole periods we fell behind on */
+            slot->next_due += slot->period_ms;
+            if (slot->next_due <= now) {
+                int64_t behind = (now - slot->next_due) / slot->period_ms + 1;
+
+                slot->overruns += (uint32_t)behind;
+                slot->next_due += behind * slot->period_ms;
+            }
+        }
+
+        next = MIN(next, slot->next_due);
+    }
+
+    if (next != INT64_MAX) {
+        sampler_schedule(smp, K_MSEC(MAX(next - now, 0)));
+    }
+
+    k_mutex_unlock(&smp->lock);
+}
+
+int i2cw_sampler_init(struct i2cw_sampler* smp, struct k_work_q* workq)
+{
+    if (!smp) {
+        return -EINVAL;
+    }
+
+    memset(smp, 0, sizeof(*smp));
+    smp->workq = workq;
+    k_mutex_init(&smp->lock);
+    k_work_init_delayable(&smp->work, sampler_work_handler);
+
+    return 0;
+}
+
+int i2cw_sampler_add(struct i2cw_sampler* smp, struct i2c_ctx* i2c, uint16_t addr, uint8_t reg, uint8_t* buf, size_t len,
+                     uint32_t period_ms, i2cw_callback_t cb, void* user_data)
+{
+    if (!smp || !i2c || !buf || len == 0 || period_ms == 0) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&smp->lock, K_FOREVER);
+
+    if (smp->num_slots == ARRAY_SIZE(smp->slots)) {
+        k_mutex_unlock(&smp->lock);
+        return -ENOMEM;
+    }
+
+    int idx = (int)smp->num_slots++;
+    struct i2cw_sample_slot* slot = &smp->slots[idx];
+
+    memset(slot, 0, sizeof(*slot));
+    slot->i2c = i2c;
+    slot->addr = addr;
+    slot->reg = reg;
+    slot->buf = buf;
+    slot->len = len;
+    slot->period_ms = period_ms;
+    slot->cb = cb;
+    slot->user_data = user_data;
+    slot->next_due = k_uptime_get() + period_ms;
+
+    if (smp->running) {
+        /* Wake up now so the timeline accounts for the new slot */
+        sampler_schedule(smp, K_NO_WAIT);
+    }
+
+    k_mutex_unlock(&smp->lock);
+    return idx;
+}
+
+int i2cw_sampler_start(struct i2cw_sampler* smp)
+{
+    if (!smp) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&smp->lock, K_FOREVER);
+
+    int64_t now = k_uptime_get();
+
+    for (size_t i = 0; i < smp->num_slots; i++) {
+        smp->slots[i].next_due = now + smp->slots[i].period_ms;
+    }
+    smp->running = true;
+    sampler_schedule(smp, K_NO_WAIT);
+
+    k_mutex_unlock(&smp->lock);
+    return 0;
+}
+
+int i2cw_sampler_stop(struct i2cw_sampler* smp)
+{
+    if (!smp) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&smp->lock, K_FOREVER);
+    smp->running = false;
+    k_mutex_unlock(&smp->lock);
+
+    (void)k_work_cancel_delayable(&smp->work);
+    return 0;
+}
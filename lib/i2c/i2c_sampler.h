@@ -0,0 +1,112 @@
+/**
+ * @file i2c_sampler.h
+ * @brief Periodic I2C register sampling scheduler.
+ *
+ * Devices register a register block to read, a period and a callback. The
+ * scheduler keeps one timeline for all slots: every wakeup queues all reads
+ * that are due (or due within CONFIG_I2C_WRAPPER_SAMPLER_WINDOW_MS) on their
+ * bus contexts, where they run back to back as one asynchronous chain. Due
+ * times advance by exactly one period, so sampling does not drift with
+ * wakeup latency.
+ */
+
+#ifndef I2C_SAMPLER_H_
+#define I2C_SAMPLER_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include "i2c_wrapper.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sampling slot.
+ */
+struct i2cw_sample_slot
+{
+    struct i2c_ctx* i2c;  /**< Bus context the read is queued on */
+    uint16_t addr;        /**< Device address */
+    uint8_t reg;          /**< First register of the block */
+    uint8_t* buf;         /**< Destination, overwritten by every sample */
+    size_t len;           /**< Block length */
+    uint32_t period_ms;   /**< Sampling period */
+    i2cw_callback_t cb;   /**< Called with the block after every sample */
+    void* user_data;      /**< Passed back to @c cb */
+    int64_t next_due;     /**< Uptime of the next sample in ms */
+    atomic_t busy;        /**< Previous sample still in flight */
+    uint32_t samples;     /**< Samples completed */
+    uint32_t overruns;    /**< Samples skipped because the previous one was still running or the queue was full */
+};
+
+/**
+ * @brief Sampler.
+ */
+struct i2cw_sampler
+{
+    struct i2cw_sample_slot slots[CONFIG_I2C_WRAPPER_SAMPLER_MAX_SLOTS]; /**< Slots */
+    size_t num_slots;                                                    /**< Slots in use */
+    struct k_work_q* workq;                                              /**< Work queue, NULL for the system one */
+    struct k_work_delayable work;                                        /**< Timeline work item */
+    struct k_mutex lock;                                                 /**< Protects the slot table */
+    bool running;                                                        /**< Timeline armed */
+    uint32_t wakeups;                                                    /**< Timeline wakeups */
+};
+
+/**
+ * @brief Initialize a sampler.
+ *
+ * @param smp   Sampler pointer
+ * @param workq Work queue running the timeline, NULL for the system work queue
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If smp is NULL
+ */
+int i2cw_sampler_init(struct i2cw_sampler* smp, struct k_work_q* workq);
+
+/**
+ * @brief Register a periodic block read.
+ *
+ * The first sample is taken one period after i2cw_sampler_start(), or one
+ * period from now if the sampler is already running.
+ *
+ * @param smp       Sampler pointer
+ * @param i2c       Initialized bus context used for the transfer
+ * @param addr      Device address
+ * @param reg       First register of the block
+ * @param buf       Destination buffer, must stay valid while registered
+ * @param len       Block length
+ * @param period_ms Sampling period in milliseconds
+ * @param cb        Callback run in the i2c_wrapper completion context
+ * @param user_data Passed back to @p cb
+ *
+ * @retval >=0 Slot index
+ * @retval -ENOMEM If all slots are used
+ * @retval -EINVAL If arguments invalid
+ */
+int i2cw_sampler_add(struct i2cw_sampler* smp, struct i2c_ctx* i2c, uint16_t addr, uint8_t reg, uint8_t* buf, size_t len,
+                     uint32_t period_ms, i2cw_callback_t cb, void* user_data);
+
+/**
+ * @brief Start the timeline.
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If smp is NULL
+ */
+int i2cw_sampler_start(struct i2cw_sampler* smp);
+
+/**
+ * @brief Stop the timeline. Reads already queued still complete.
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If smp is NULL
+ */
+int i2cw_sampler_stop(struct i2cw_sampler* smp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // I2C_SAMPLER_H_
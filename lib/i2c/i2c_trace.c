@@ -0,0 +1,139 @@
+#include "i2c_trace.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/util.h>
+#if CONFIG_I2C_WRAPPER_TRACE_SHELL
+    #include <zephyr/shell/shell.h>
+#endif
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_I2C_WRAPPER_TRACE_DEPTH), "I2C_WRAPPER_TRACE_DEPTH must be a power of two");
+
+#define TRACE_MASK (CONFIG_I2C_WRAPPER_TRACE_DEPTH - 1)
+
+static struct i2cw_trace_rec trace_ring[CONFIG_I2C_WRAPPER_TRACE_DEPTH];
+static atomic_t trace_seq;
+
+void i2cw_trace_record(uint16_t addr, const struct i2c_msg* msgs, uint8_t num_msgs, uint32_t t_submit, uint32_t t_start, int result,
+                       uint8_t attempt)
+{
+    uint32_t t_done = k_cycle_get_32();
+    uint32_t seq = (uint32_t)atomic_inc(&trace_seq);
+    struct i2cw_trace_rec* rec = &trace_ring[seq & TRACE_MASK];
+    bool rd = false;
+    bool wr = false;
+    uint32_t len = 0;
+
+    for (uint8_t i = 0; i < num_msgs; i++) {
+        if (msgs[i].flags & I2C_MSG_READ) {
+            rd = true;
+        }
+        else {
+            wr = true;
+        }
+        len += msgs[i].len;
+    }
+
+    /* Invalidate first so a concurrent reader never sees a half-written record as valid */
+    rec->seq = 0;
+    barrier_dmem_fence_full();
+    rec->t_submit = t_submit;
+    rec->t_start = t_start;
+    rec->t_done = t_done;
+    rec->addr = addr;
+    rec->len = (uint16_t)MIN(len, UINT16_MAX);
+    rec->result = (int16_t)result;
+    rec->dir = rd && wr ? I2CW_TRACE_WRITE_READ : (rd ? I2CW_TRACE_READ : I2CW_TRACE_WRITE);
+    rec->attempt = attempt;
+    barrier_dmem_fence_full();
+    rec->seq = seq + 1;
+}
+
+/*
+ * Copy the record with sequence number @p seq. The slot's seq is read again
+ * after the copy: if a writer started on the slot meanwhile, the copy may be
+ * torn and is dropped.
+ */
+static bool trace_read(uint32_t seq, struct i2cw_trace_rec* out)
+{
+    const struct i2cw_trace_rec* rec = &trace_ring[seq & TRACE_MASK];
+    const volatile uint32_t* slot_seq = &rec->seq;
+
+    if (*slot_seq != seq + 1) {
+        return false;
+    }
+    barrier_dmem_fence_full();
+    *out = *rec;
+    barrier_dmem_fence_full();
+
+    return *slot_seq == seq + 1;
+}
+
+size_t i2cw_trace_snapshot(struct i2cw_trace_rec* out, size_t max)
+{
+    uint32_t end = (uint32_t)atomic_get(&trace_seq);
+    uint32_t begin = end > CONFIG_I2C_WRAPPER_TRACE_DEPTH ? end - CONFIG_I2C_WRAPPER_TRACE_DEPTH : 0;
+    size_t n = 0;
+
+    for (uint32_t seq = begin; seq != end && n < max; seq++) {
+        /* Skip slots being rewritten or already overwritten by a newer record */
+        if (trace_read(seq, &out[n])) {
+            n++;
+        }
+    }
+    return n;
+}
+
+void i2cw_trace_clear(void)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(trace_ring); i++) {
+        trace_ring[i].seq = 0;
+    }
+}
+
+#if CONFIG_I2C_WRAPPER_TRACE_SHELL
+static int cmd_i2cw_trace_dump(const struct shell* sh, size_t argc, char** argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    struct i2cw_trace_rec rec;
+    uint32_t end = (uint32_t)atomic_get(&trace_seq);
+    uint32_t begin = end > CONFIG_I2C_WRAPPER_TRACE_DEPTH ? end - CONFIG_I2C_WRAPPER_TRACE_DEPTH : 0;
+
+    /* Line format is parsed by scripts/i2c_trace_to_chrome.py */
+    shell_print(sh, "I2CTRACE hz=%u", sys_clock_hw_cycles_per_sec());
+    for (uint32_t seq = begin; seq != end; seq++) {
+        if (!trace_read(seq, &rec)) {
+            continue;
+        }
+        shell_print(sh, "I2CTRACE %u 0x%02x %u %u %u %u %u %d %u", seq, rec.addr, rec.dir, rec.len, rec.t_submit, rec.t_start, rec.t_done,
+                    rec.result, rec.attempt);
+    }
+    shell_print(sh, "I2CTRACE end");
+    return 0;
+}
+
+static int cmd_i2cw_trace_clear(const struct shell* sh, size_t argc, char** argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    i2cw_trace_clear();
+    shell_print(sh, "trace cleared");
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_i2cw_trace,
+                               SHELL_CMD(dump, NULL, "Dump the transfer trace ring", cmd_i2cw_trace_dump),
+                               SHELL_CMD(clear, NULL, "Clear the transfer trace ring", cmd_i2cw_trace_clear),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_i2cw,
+                               SHELL_CMD(trace, &sub_i2cw_trace, "Transfer trace commands", NULL),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(i2cw, &sub_i2cw, "I2C wrapper commands", NULL);
+#endif
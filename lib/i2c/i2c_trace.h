@@ -0,0 +1,97 @@
+/**
+ * @file i2c_trace.h
+ * @brief Transfer trace ring for the I2C wrapper.
+ *
+ * With CONFIG_I2C_WRAPPER_TRACE every transfer attempt, blocking or queued,
+ * is recorded with k_cycle_get_32() timestamps for submission, bus start and
+ * completion. The ring is written lock-free from any context and can be
+ * dumped with the "i2cw trace" shell command; scripts/i2c_trace_to_chrome.py
+ * turns the dump into a Chrome trace-event file. Without the option the
+ * hooks compile to nothing.
+ */
+
+#ifndef I2C_TRACE_H_
+#define I2C_TRACE_H_
+
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Transfer direction.
+ */
+enum i2cw_trace_dir {
+    I2CW_TRACE_WRITE,      /**< Only write messages */
+    I2CW_TRACE_READ,       /**< Only read messages */
+    I2CW_TRACE_WRITE_READ, /**< Write followed by read */
+};
+
+/**
+ * @brief Trace record.
+ */
+struct i2cw_trace_rec
+{
+    uint32_t seq;      /**< Sequence number + 1, written last; 0 marks an empty or torn slot */
+    uint32_t t_submit; /**< Cycle count when the transfer was requested */
+    uint32_t t_start;  /**< Cycle count when it was handed to the driver */
+    uint32_t t_done;   /**< Cycle count when it completed */
+    uint16_t addr;     /**< Target address */
+    uint16_t len;      /**< Payload bytes over all messages */
+    int16_t result;    /**< 0 or negative errno */
+    uint8_t dir;       /**< enum i2cw_trace_dir */
+    uint8_t attempt;   /**< Retry number, 0 for the first attempt */
+};
+
+#if CONFIG_I2C_WRAPPER_TRACE
+
+/** @brief Timestamp for the trace hooks. */
+    #define I2CW_TRACE_TS() k_cycle_get_32()
+
+/**
+ * @brief Record one finished transfer attempt.
+ */
+void i2cw_trace_record(uint16_t addr, const struct i2c_msg* msgs, uint8_t num_msgs, uint32_t t_submit, uint32_t t_start, int result,
+                       uint8_t attempt);
+
+/**
+ * @brief Copy records out of the ring, oldest first.
+ *
+ * Records that are overwritten while being copied are left out.
+ *
+ * @param out Destination array
+ * @param max Capacity of @p out
+ * @return Number of records copied
+ */
+size_t i2cw_trace_snapshot(struct i2cw_trace_rec* out, size_t max);
+
+/**
+ * @brief Drop all records.
+ */
+void i2cw_trace_clear(void);
+
+#else
+
+    #define I2CW_TRACE_TS() 0U
+
+static inline void i2cw_trace_record(uint16_t addr, const struct i2c_msg* msgs, uint8_t num_msgs, uint32_t t_submit, uint32_t t_start,
+                                     int result, uint8_t attempt)
+{
+    ARG_UNUSED(addr);
+    ARG_UNUSED(msgs);
+    ARG_UNUSED(num_msgs);
+    ARG_UNUSED(t_submit);
+    ARG_UNUSED(t_start);
+    ARG_UNUSED(result);
+    ARG_UNUSED(attempt);
+}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // I2C_TRACE_H_
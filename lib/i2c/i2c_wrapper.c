@@ -1,37 +1,463 @@
 #include "i2c_wrapper.h"
 
+#include <string.h>
+#include <zephyr/init.h>
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(i2cw, CONFIG_I2C_LOG_LEVEL);
 
-/* Internal i2c callback that raises the poll signal */
-#if defined(CONFIG_I2C_CALLBACK)
+#if CONFIG_I2C_WRAPPER_COMPLETION_WORKQ
+static struct k_work_q i2cw_workq;
+static K_THREAD_STACK_DEFINE(i2cw_workq_stack, CONFIG_I2C_WRAPPER_WORKQ_STACK_SIZE);
+
+static int i2cw_workq_init(void)
+{
+    const struct k_work_queue_config cfg = {.name = "i2cw_wq"};
+
+    k_work_queue_start(&i2cw_workq, i2cw_workq_stack, K_THREAD_STACK_SIZEOF(i2cw_workq_stack), CONFIG_I2C_WRAPPER_WORKQ_PRIORITY, &cfg);
+    return 0;
+}
+
+SYS_INIT(i2cw_workq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif
+
+#define I2CW_BACKOFF_MS(attempt)  (CONFIG_I2C_WRAPPER_RETRY_BACKOFF_MS << (attempt))
+#define I2CW_NEEDS_RECOVERY(ret) ((ret) == -EIO || (ret) == -ETIMEDOUT)
+
+static void i2cw_txn_complete(struct i2c_ctx* ctx, atomic_val_t gen, int result);
+
+/* Delayed items run on the completion work queue, or the system one. */
+static void i2cw_schedule(struct k_work_delayable* dwork, k_timeout_t delay)
+{
+#if CONFIG_I2C_WRAPPER_COMPLETION_WORKQ
+    (void)k_work_reschedule_for_queue(&i2cw_workq, dwork, delay);
+#else
+    (void)k_work_reschedule(dwork, delay);
+#endif
+}
+
+/* Count a failed attempt against @p addr. */
+static void i2cw_account(struct i2c_ctx* ctx, uint16_t addr, int result, bool retry)
+{
+    if (result == 0) {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->txn_lock);
+    struct i2cw_stats* st = &ctx->stats;
+    struct i2cw_addr_stats* as = NULL;
+
+    for (uint8_t i = 0; i < st->num_addr; i++) {
+        if (st->addr[i].addr == addr) {
+            as = &st->addr[i];
+            break;
+        }
+    }
+    if (!as && st->num_addr < ARRAY_SIZE(st->addr)) {
+        as = &st->addr[st->num_addr++];
+        as->addr = addr;
+    }
+
+    st->failures++;
+    st->timeouts += result == -ETIMEDOUT;
+    st->retries += retry;
+    st->gave_up += !retry;
+    if (as) {
+        as->failures++;
+        as->timeouts += result == -ETIMEDOUT;
+        as->retries += retry;
+    }
+    k_spin_unlock(&ctx->txn_lock, key);
+}
+
+/* Try to free a stuck bus. Caller owns the bus and runs in thread context. */
+static void i2cw_recover(struct i2c_ctx* ctx)
+{
+#if CONFIG_I2C_WRAPPER_RECOVER_BUS
+    int ret = i2c_recover_bus(ctx->bus.bus);
+
+    LOG_WRN("Bus recovery (%d)", ret);
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->txn_lock);
+    ctx->stats.recoveries++;
+    k_spin_unlock(&ctx->txn_lock, key);
+#else
+    ARG_UNUSED(ctx);
+#endif
+}
+
+/* Bus arbitration around one blocking transaction; no-ops without an arbiter. */
+static int i2cw_arb_lock(struct i2c_ctx* ctx)
+{
+#if CONFIG_I2C_WRAPPER_ARBITER
+    if (ctx->arb) {
+        return i2cw_bus_acquire(ctx->arb, ctx->arb_prio, K_FOREVER);
+    }
+#endif
+    ARG_UNUSED(ctx);
+    return 0;
+}
+
+static void i2cw_arb_unlock(struct i2c_ctx* ctx)
+{
+#if CONFIG_I2C_WRAPPER_ARBITER
+    if (ctx->arb) {
+        i2cw_bus_release(ctx->arb);
+    }
+#endif
+    ARG_UNUSED(ctx);
+}
+
+static int i2cw_transfer_locked(struct i2c_ctx* ctx, struct i2c_msg* msgs, uint8_t num_msgs)
+{
+    for (uint8_t attempt = 0;; attempt++) {
+        uint32_t t_submit = I2CW_TRACE_TS();
+        int ret = i2cw_arb_lock(ctx);
+        if (ret) {
+            return ret;
+        }
+
+        uint32_t t_start = I2CW_TRACE_TS();
+
+        ret = i2c_transfer_dt(&ctx->bus, msgs, num_msgs);
+        i2cw_trace_record(ctx->bus.addr, msgs, num_msgs, t_submit, t_start, ret, attempt);
+        if (I2CW_NEEDS_RECOVERY(ret)) {
+            i2cw_recover(ctx);
+        }
+        i2cw_arb_unlock(ctx);
+
+        bool retry = ret && attempt < CONFIG_I2C_WRAPPER_RETRIES;
+
+        i2cw_account(ctx, ctx->bus.addr, ret, retry);
+        if (!retry) {
+            return ret;
+        }
+        k_msleep(I2CW_BACKOFF_MS(attempt));
+    }
+}
+
+/* Hand the result of attempt @p gen to the configured completion context. */
+static void i2cw_txn_done(struct i2c_ctx* ctx, atomic_val_t gen, int result)
+{
+#if CONFIG_I2C_WRAPPER_COMPLETION_DIRECT
+    i2cw_txn_complete(ctx, gen, result);
+#else
+    /* Drop a late completion here, so it cannot overwrite the one of the current attempt */
+    if (atomic_get(&ctx->xfer_active) != gen) {
+        return;
+    }
+    ctx->done_gen = gen;
+    ctx->done_result = result;
+    #if CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+    /* worker thread will pick it up */
+    k_poll_signal_raise(&ctx->async_signal, result);
+    #else
+    k_work_submit_to_queue(&i2cw_workq, &ctx->done_work);
+    #endif
+#endif
+}
+
+/* Internal i2c callback, runs in the driver's completion context */
 static void i2cw_i2c_cb(const struct device* dev, int result, void* userdata)
 {
-    struct k_poll_signal* sig = (struct k_poll_signal*)userdata;
-    if (sig) {
-        /* raise the signal with the result; worker thread will pick it up */
-        k_poll_signal_raise(sig, result);
+    struct i2cw_xfer_tag* tag = userdata;
+
+    ARG_UNUSED(dev);
+    /* Free the slot; the generation tells whether this attempt is still the current one */
+    i2cw_txn_done(tag->ctx, atomic_clear(&tag->gen), result);
+}
+
+/* Take a free callback token for attempt @p gen, NULL if every slot still waits for the driver. */
+static struct i2cw_xfer_tag* i2cw_xfer_tag_get(struct i2c_ctx* ctx, atomic_val_t gen)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(ctx->xfer_tags); i++) {
+        if (atomic_cas(&ctx->xfer_tags[i].gen, 0, gen)) {
+            return &ctx->xfer_tags[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Put the head transaction on the bus. A failure to start completes it with
+ * the error. Every attempt gets a new generation, so the completion of an
+ * attempt that already timed out cannot finish its retry.
+ */
+static void i2cw_txn_xfer(struct i2c_ctx* ctx)
+{
+    struct i2cw_txn* txn = &ctx->txn_queue[ctx->txn_head];
+    struct i2cw_xfer_tag* tag;
+    atomic_val_t gen;
+    int ret;
+
+    if (++ctx->xfer_gen == 0) {
+        ctx->xfer_gen = 1;
+    }
+    gen = (atomic_val_t)ctx->xfer_gen;
+
+#if CONFIG_I2C_WRAPPER_TRACE
+    txn->t_start = I2CW_TRACE_TS();
+#endif
+#if CONFIG_I2C_WRAPPER_TIMEOUT_MS > 0
+    #if CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+    ctx->deadline = sys_timepoint_calc(K_MSEC(CONFIG_I2C_WRAPPER_TIMEOUT_MS));
+    #else
+    i2cw_schedule(&ctx->wdog, K_MSEC(CONFIG_I2C_WRAPPER_TIMEOUT_MS));
+    #endif
+#endif
+    atomic_set(&ctx->xfer_active, gen);
+#if CONFIG_I2C_WRAPPER_TIMEOUT_MS > 0 && CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+    /* Let the worker pick up the new deadline */
+    k_poll_signal_raise(&ctx->kick_signal, 0);
+#endif
+
+    tag = i2cw_xfer_tag_get(ctx, gen);
+    if (!tag) {
+        /* The driver still owes the completions of earlier attempts */
+        ret = -EBUSY;
+    }
+    else {
+        ret = i2c_transfer_cb(ctx->bus.bus, txn->msgs, txn->num_msgs, txn->addr, i2cw_i2c_cb, tag);
+        if (ret) {
+            /* No callback will come for a transfer that did not start */
+            atomic_clear(&tag->gen);
+        }
+    }
+
+    if (ret) {
+        LOG_ERR("Async transfer start failed (%d)", ret);
+        i2cw_txn_done(ctx, gen, ret);
+    }
+}
+
+#if CONFIG_I2C_WRAPPER_ARBITER
+static void i2cw_arb_granted(struct i2cw_bus_waiter* waiter)
+{
+    i2cw_txn_xfer(CONTAINER_OF(waiter, struct i2c_ctx, arb_waiter));
+}
+#endif
+
+/* Start the head transaction once this context owns the bus. */
+static void i2cw_txn_start(struct i2c_ctx* ctx)
+{
+#if CONFIG_I2C_WRAPPER_ARBITER
+    if (ctx->arb && i2cw_bus_acquire_async(ctx->arb, &ctx->arb_waiter, ctx->arb_prio, i2cw_arb_granted) == -EINPROGRESS) {
+        return;
+    }
+#endif
+    i2cw_txn_xfer(ctx);
+}
+
+/* Retire or retry the head transaction, chain the next one, then run the callback. */
+static void i2cw_txn_finish(struct i2c_ctx* ctx, int result)
+{
+    struct i2cw_txn* head = &ctx->txn_queue[ctx->txn_head];
+    bool recover = IS_ENABLED(CONFIG_I2C_WRAPPER_RECOVER_BUS) && I2CW_NEEDS_RECOVERY(result);
+    bool retry = result && head->attempts < CONFIG_I2C_WRAPPER_RETRIES;
+
+#if CONFIG_I2C_WRAPPER_TRACE
+    i2cw_trace_record(head->addr, head->msgs, head->num_msgs, head->t_submit, head->t_start, result, head->attempts);
+#endif
+    i2cw_account(ctx, head->addr, result, retry);
+
+    if (retry) {
+        /* Back off with the bus released; recovery, if any, runs first */
+        uint8_t attempt = head->attempts++;
+
+        ctx->recover_pending = recover;
+        i2cw_arb_unlock(ctx);
+        i2cw_schedule(&ctx->retry_work, K_MSEC(I2CW_BACKOFF_MS(attempt)));
+        return;
+    }
+
+    struct i2cw_txn done;
+    bool next;
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->txn_lock);
+    done = *head;
+    ctx->txn_head = (ctx->txn_head + 1) % CONFIG_I2C_WRAPPER_QUEUE_DEPTH;
+    ctx->txn_count--;
+    next = ctx->txn_count > 0;
+    /* Stay busy through a pending recovery so new submissions queue behind it */
+    ctx->txn_busy = next || recover;
+    ctx->recover_pending = recover;
+    k_spin_unlock(&ctx->txn_lock, key);
+
+    /* Give waiters of higher priority the bus before our next transaction */
+    i2cw_arb_unlock(ctx);
+
+    if (recover) {
+        i2cw_schedule(&ctx->retry_work, K_NO_WAIT);
     }
+    else if (next) {
+        i2cw_txn_start(ctx);
+    }
+
+    if (!done.cb) {
+        return;
+    }
+
+    /* Report the last read message, or the last message if nothing was read */
+    const struct i2c_msg* msg = &done.msgs[done.num_msgs - 1];
+    for (int i = done.num_msgs - 1; i >= 0; i--) {
+        if (done.msgs[i].flags & I2C_MSG_READ) {
+            msg = &done.msgs[i];
+            break;
+        }
+    }
+
+    done.cb(done.user_data, result, msg->buf, msg->len);
 }
+
+/* Attempt @p gen finished. Ignores late completions of an attempt that already timed out. */
+static void i2cw_txn_complete(struct i2c_ctx* ctx, atomic_val_t gen, int result)
+{
+    if (!atomic_cas(&ctx->xfer_active, gen, 0)) {
+        return;
+    }
+#if CONFIG_I2C_WRAPPER_TIMEOUT_MS > 0 && !CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+    (void)k_work_cancel_delayable(&ctx->wdog);
 #endif
+    i2cw_txn_finish(ctx, result);
+}
+
+/* Transfer deadline passed. */
+static void i2cw_txn_timeout(struct i2c_ctx* ctx)
+{
+    atomic_val_t gen = atomic_get(&ctx->xfer_active);
+
+    if (!gen || !atomic_cas(&ctx->xfer_active, gen, 0)) {
+        return;
+    }
+    LOG_WRN("Transfer to 0x%02x timed out", ctx->txn_queue[ctx->txn_head].addr);
+    i2cw_txn_finish(ctx, -ETIMEDOUT);
+}
+
+#if CONFIG_I2C_WRAPPER_ARBITER
+static void i2cw_arb_recover_granted(struct i2cw_bus_waiter* waiter)
+{
+    struct i2c_ctx* ctx = CONTAINER_OF(waiter, struct i2c_ctx, arb_waiter);
+
+    /* The grant may run in an ISR; recover from the retry work with the bus held */
+    ctx->recover_granted = true;
+    i2cw_schedule(&ctx->retry_work, K_NO_WAIT);
+}
+#endif
+
+/*
+ * Take the bus for a recovery from the retry work without blocking the work
+ * queue. Returns false if the bus is busy; the work is then queued again once
+ * the bus is handed over.
+ */
+static bool i2cw_arb_lock_recovery(struct i2c_ctx* ctx)
+{
+#if CONFIG_I2C_WRAPPER_ARBITER
+    if (ctx->arb && !ctx->recover_granted &&
+        i2cw_bus_acquire_async(ctx->arb, &ctx->arb_waiter, ctx->arb_prio, i2cw_arb_recover_granted) == -EINPROGRESS) {
+        return false;
+    }
+#endif
+    ctx->recover_granted = false;
+    return true;
+}
+
+static void i2cw_retry_work_handler(struct k_work* work)
+{
+    struct k_work_delayable* dwork = k_work_delayable_from_work(work);
+    struct i2c_ctx* ctx = CONTAINER_OF(dwork, struct i2c_ctx, retry_work);
+
+    if (ctx->recover_pending) {
+        if (!i2cw_arb_lock_recovery(ctx)) {
+            return;
+        }
+        ctx->recover_pending = false;
+        i2cw_recover(ctx);
+        i2cw_arb_unlock(ctx);
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->txn_lock);
+    bool start = ctx->txn_count > 0;
+    ctx->txn_busy = start;
+    k_spin_unlock(&ctx->txn_lock, key);
+
+    if (start) {
+        i2cw_txn_start(ctx);
+    }
+}
 
+#if CONFIG_I2C_WRAPPER_TIMEOUT_MS > 0 && !CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+static void i2cw_wdog_handler(struct k_work* work)
+{
+    struct k_work_delayable* dwork = k_work_delayable_from_work(work);
+
+    i2cw_txn_timeout(CONTAINER_OF(dwork, struct i2c_ctx, wdog));
+}
+#endif
+
+#if CONFIG_I2C_WRAPPER_COMPLETION_THREAD
 static void i2c_worker(void* p1, void* p2, void* p3)
 {
     struct i2c_ctx* ctx = (struct i2c_ctx*)p1;
 
     while (ctx->worker_running) {
-        k_poll(&ctx->async_event, 1, K_FOREVER);
+        k_timeout_t timeout = K_FOREVER;
+
+#if CONFIG_I2C_WRAPPER_TIMEOUT_MS > 0
+        if (atomic_get(&ctx->xfer_active)) {
+            timeout = sys_timepoint_timeout(ctx->deadline);
+        }
+#endif
+        int rc = k_poll(ctx->async_events, ARRAY_SIZE(ctx->async_events), timeout);
+        if (!ctx->worker_running) {
+            break;
+        }
 
         unsigned int signaled;
         int result;
 
+        /* A kick only means a transfer started; loop to pick up its deadline */
+        k_poll_signal_reset(&ctx->kick_signal);
+        ctx->async_events[1].state = K_POLL_STATE_NOT_READY;
+
         k_poll_signal_check(&ctx->async_signal, &signaled, &result);
-        k_poll_signal_reset(&ctx->async_signal);
+        if (signaled) {
+            k_poll_signal_reset(&ctx->async_signal);
+            ctx->async_events[0].state = K_POLL_STATE_NOT_READY;
+            /* The signal only wakes us up, the attempt's generation and result come with it */
+            i2cw_txn_complete(ctx, ctx->done_gen, ctx->done_result);
+        }
+        else if (rc == -EAGAIN) {
+            i2cw_txn_timeout(ctx);
+        }
+    }
+}
+#elif CONFIG_I2C_WRAPPER_COMPLETION_WORKQ
+static void i2cw_done_work_handler(struct k_work* work)
+{
+    struct i2c_ctx* ctx = CONTAINER_OF(work, struct i2c_ctx, done_work);
+
+    i2cw_txn_complete(ctx, ctx->done_gen, ctx->done_result);
+}
+#endif
 
-        if (signaled && ctx->callback) {
-            ctx->callback(ctx->cb_user_data, result, ctx->rx_buf, ctx->rx_len);
+/* Wait until the driver has called back for every attempt it started. Returns false on timeout. */
+static bool i2cw_xfer_drain(struct i2c_ctx* ctx, k_timeout_t timeout)
+{
+    k_timepoint_t end = sys_timepoint_calc(timeout);
+
+    for (;;) {
+        bool owed = false;
+
+        for (size_t i = 0; i < ARRAY_SIZE(ctx->xfer_tags); i++) {
+            owed |= atomic_get(&ctx->xfer_tags[i].gen) != 0;
+        }
+        if (!owed) {
+            return true;
+        }
+        if (sys_timepoint_expired(end)) {
+            return false;
         }
+        k_sleep(K_MSEC(1));
     }
 }
 
@@ -47,19 +473,49 @@ int i2cw_init(struct i2c_ctx* ctx, const struct i2c_dt_spec* bus_dt, k_thread_st
     }
 
     ctx->bus = *bus_dt;
-    k_poll_signal_init(&ctx->async_signal);
-    ctx->async_event = (struct k_poll_event)K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &ctx->async_signal);
 
     ctx->callback = NULL;
     ctx->cb_user_data = NULL;
-    ctx->rx_buf = NULL;
-    ctx->rx_len = 0;
+    ctx->txn_head = 0;
+    ctx->txn_count = 0;
+    ctx->txn_busy = false;
+    atomic_clear(&ctx->xfer_active);
+    /* xfer_gen keeps counting, so completions owed from before a re-init stay stale */
+    for (size_t i = 0; i < ARRAY_SIZE(ctx->xfer_tags); i++) {
+        ctx->xfer_tags[i].ctx = ctx;
+        atomic_clear(&ctx->xfer_tags[i].gen);
+    }
+    ctx->recover_pending = false;
+    ctx->recover_granted = false;
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+    k_work_init_delayable(&ctx->retry_work, i2cw_retry_work_handler);
+#if CONFIG_I2C_WRAPPER_TIMEOUT_MS > 0 && !CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+    k_work_init_delayable(&ctx->wdog, i2cw_wdog_handler);
+#endif
+
+#if CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+    if (!stack || stack_size == 0) {
+        return -EINVAL;
+    }
+
+    k_poll_signal_init(&ctx->async_signal);
+    k_poll_signal_init(&ctx->kick_signal);
+    k_poll_event_init(&ctx->async_events[0], K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &ctx->async_signal);
+    k_poll_event_init(&ctx->async_events[1], K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &ctx->kick_signal);
 
     ctx->worker_stack = stack;
     ctx->worker_stack_size = stack_size;
     ctx->worker_running = true;
 
     k_thread_create(&ctx->worker_thread, ctx->worker_stack, ctx->worker_stack_size, i2c_worker, ctx, NULL, NULL, prio, 0, K_NO_WAIT);
+#else
+    ARG_UNUSED(stack);
+    ARG_UNUSED(stack_size);
+    ARG_UNUSED(prio);
+#if CONFIG_I2C_WRAPPER_COMPLETION_WORKQ
+    k_work_init(&ctx->done_work, i2cw_done_work_handler);
+#endif
+#endif
 
     return 0;
 }
@@ -70,6 +526,7 @@ int i2cw_deinit(struct i2c_ctx* ctx)
         return -EINVAL;
     }
 
+#if CONFIG_I2C_WRAPPER_COMPLETION_THREAD
     /* Stop the worker thread loop */
     ctx->worker_running = false;
 
@@ -78,13 +535,69 @@ int i2cw_deinit(struct i2c_ctx* ctx)
 
     /* Wait until thread exits */
     k_thread_join(&ctx->worker_thread, K_FOREVER);
+#elif CONFIG_I2C_WRAPPER_COMPLETION_WORKQ
+    struct k_work_sync sync;
+
+    (void)k_work_cancel_sync(&ctx->done_work, &sync);
+#endif
+    {
+        struct k_work_sync dsync;
+
+        (void)k_work_cancel_delayable_sync(&ctx->retry_work, &dsync);
+#if CONFIG_I2C_WRAPPER_TIMEOUT_MS > 0 && !CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+        (void)k_work_cancel_delayable_sync(&ctx->wdog, &dsync);
+#endif
+    }
+    /* Claim a transfer still in flight, so its late completion is ignored */
+    bool in_flight = atomic_clear(&ctx->xfer_active) != 0;
+    int ret = 0;
+
+    /*
+     * The controller may still be moving data of a started transfer. Give it
+     * the transfer deadline to call back, then recover the bus to abort it,
+     * but only while we own the bus.
+     */
+    k_timeout_t drain = CONFIG_I2C_WRAPPER_TIMEOUT_MS > 0 ? K_MSEC(CONFIG_I2C_WRAPPER_TIMEOUT_MS) : K_FOREVER;
+    bool drained = i2cw_xfer_drain(ctx, drain);
+
+    if (!drained && in_flight) {
+        int rc = i2c_recover_bus(ctx->bus.bus);
+
+        LOG_WRN("Transfer still running at deinit, bus recovery (%d)", rc);
+        drained = i2cw_xfer_drain(ctx, drain);
+    }
+    if (!drained) {
+        LOG_ERR("Controller did not return a transfer");
+        ret = -ETIMEDOUT;
+    }
 
+#if CONFIG_I2C_WRAPPER_ARBITER
+    if (ctx->arb) {
+        /* A transfer in flight or a granted recovery holds the bus, a queued one only waits for it */
+        if (in_flight || ctx->recover_granted) {
+            i2cw_bus_release(ctx->arb);
+        }
+        else {
+            (void)i2cw_bus_cancel(ctx->arb, &ctx->arb_waiter);
+        }
+    }
+#else
+    ARG_UNUSED(in_flight);
+#endif
+
+    /* Queued transactions are dropped without callbacks */
+    k_spinlock_key_t key = k_spin_lock(&ctx->txn_lock);
+    ctx->txn_head = 0;
+    ctx->txn_count = 0;
+    ctx->txn_busy = false;
+    k_spin_unlock(&ctx->txn_lock, key);
+
+    ctx->recover_pending = false;
+    ctx->recover_granted = false;
     ctx->callback = NULL;
     ctx->cb_user_data = NULL;
-    ctx->rx_buf = NULL;
-    ctx->rx_len = 0;
 
-    return 0;
+    return ret;
 }
 
 int i2cw_write(struct i2c_ctx* ctx, const uint8_t* buf, size_t len)
@@ -93,7 +606,9 @@ int i2cw_write(struct i2c_ctx* ctx, const uint8_t* buf, size_t len)
         return -EINVAL;
     }
 
-    return i2c_write_dt(&ctx->bus, buf, len);
+    struct i2c_msg msg = {.buf = (uint8_t*)buf, .len = len, .flags = I2C_MSG_WRITE | I2C_MSG_STOP};
+
+    return i2cw_transfer_locked(ctx, &msg, 1);
 }
 
 int i2cw_read(struct i2c_ctx* ctx, uint8_t* buf, size_t len)
@@ -102,7 +617,9 @@ int i2cw_read(struct i2c_ctx* ctx, uint8_t* buf, size_t len)
         return -EINVAL;
     }
 
-    return i2c_read_dt(&ctx->bus, buf, len);
+    struct i2c_msg msg = {.buf = buf, .len = len, .flags = I2C_MSG_READ | I2C_MSG_STOP};
+
+    return i2cw_transfer_locked(ctx, &msg, 1);
 }
 
 int i2cw_write_read(struct i2c_ctx* ctx, const uint8_t* tx_buf, size_t tx_len, uint8_t* rx_buf, size_t rx_len)
@@ -111,9 +628,144 @@ int i2cw_write_read(struct i2c_ctx* ctx, const uint8_t* tx_buf, size_t tx_len, u
         return -EINVAL;
     }
 
-    return i2c_write_read_dt(&ctx->bus, tx_buf, tx_len, rx_buf, rx_len);
+    struct i2c_msg msgs[2] = {
+        {.buf = (uint8_t*)tx_buf, .len = tx_len, .flags = I2C_MSG_WRITE},
+        {.buf = rx_buf, .len = rx_len, .flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP},
+    };
+
+    return i2cw_transfer_locked(ctx, msgs, ARRAY_SIZE(msgs));
+}
+
+int i2cw_transfer(struct i2c_ctx* ctx, struct i2c_msg* msgs, uint8_t num_msgs)
+{
+    if (!ctx || !msgs || num_msgs == 0) {
+        return -EINVAL;
+    }
+
+    return i2cw_transfer_locked(ctx, msgs, num_msgs);
+}
+
+int i2cw_burst_read(struct i2c_ctx* ctx, uint8_t reg, uint8_t* buf, size_t len)
+{
+    if (!ctx || !buf || len == 0) {
+        return -EINVAL;
+    }
+
+    struct i2c_msg msgs[2] = {
+        {.buf = &reg, .len = 1, .flags = I2C_MSG_WRITE},
+        {.buf = buf, .len = len, .flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP},
+    };
+
+    return i2cw_transfer_locked(ctx, msgs, ARRAY_SIZE(msgs));
 }
 
+int i2cw_burst_write(struct i2c_ctx* ctx, uint8_t reg, const uint8_t* buf, size_t len)
+{
+    const struct i2cw_seg seg = {.buf = buf, .len = len};
+
+    return i2cw_burst_writev(ctx, reg, &seg, 1);
+}
+
+int i2cw_burst_writev(struct i2c_ctx* ctx, uint8_t reg, const struct i2cw_seg* segs, size_t nsegs)
+{
+    if (!ctx || !segs || nsegs == 0 || nsegs > CONFIG_I2C_WRAPPER_BURST_MAX_SEGS) {
+        return -EINVAL;
+    }
+    size_t total = 0;
+
+    for (size_t i = 0; i < nsegs; i++) {
+        if (!segs[i].buf || segs[i].len == 0) {
+            return -EINVAL;
+        }
+        total += segs[i].len;
+    }
+    /* A split burst restarts at the register it reached, which must not wrap past 0xff */
+    if (reg + total > 0x100) {
+        return -EINVAL;
+    }
+
+    size_t budget = SIZE_MAX;
+#if CONFIG_I2C_WRAPPER_ARBITER
+    if (ctx->arb && ctx->arb->budget) {
+        budget = ctx->arb->budget;
+    }
+#endif
+
+    struct i2c_msg msgs[1 + CONFIG_I2C_WRAPPER_BURST_MAX_SEGS];
+    size_t seg = 0;
+    size_t off = 0;
+    int ret = 0;
+
+    /* One transaction per budget; each restarts at the register it reached */
+    while (seg < nsegs && ret == 0) {
+        uint8_t start = reg;
+        size_t room = budget;
+        uint8_t n = 0;
+
+        msgs[n++] = (struct i2c_msg){.buf = &start, .len = 1, .flags = I2C_MSG_WRITE};
+        while (seg < nsegs && room) {
+            size_t take = MIN(segs[seg].len - off, room);
+
+            /* No RESTART: the segment continues the write started by the address */
+            msgs[n++] = (struct i2c_msg){.buf = (uint8_t*)segs[seg].buf + off, .len = take, .flags = I2C_MSG_WRITE};
+            room -= take;
+            off += take;
+            reg += take;
+            if (off == segs[seg].len) {
+                seg++;
+                off = 0;
+            }
+        }
+        msgs[n - 1].flags |= I2C_MSG_STOP;
+
+        ret = i2cw_transfer_locked(ctx, msgs, n);
+#if CONFIG_I2C_WRAPPER_ARBITER
+        if (ctx->arb && seg < nsegs) {
+            i2cw_bus_count_chunk(ctx->arb);
+        }
+#endif
+    }
+
+    return ret;
+}
+
+int i2cw_get_stats(struct i2c_ctx* ctx, struct i2cw_stats* stats)
+{
+    if (!ctx || !stats) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->txn_lock);
+    *stats = ctx->stats;
+    k_spin_unlock(&ctx->txn_lock, key);
+    return 0;
+}
+
+int i2cw_reset_stats(struct i2c_ctx* ctx)
+{
+    if (!ctx) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->txn_lock);
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+    k_spin_unlock(&ctx->txn_lock, key);
+    return 0;
+}
+
+#if CONFIG_I2C_WRAPPER_ARBITER
+int i2cw_attach_bus(struct i2c_ctx* ctx, struct i2cw_bus* bus, enum i2cw_prio prio)
+{
+    if (!ctx || prio >= I2CW_PRIO_COUNT || (bus && bus->dev != ctx->bus.bus)) {
+        return -EINVAL;
+    }
+
+    ctx->arb = bus;
+    ctx->arb_prio = prio;
+    return 0;
+}
+#endif
+
 /* ---- Async Support ---- */
 
 int i2cw_register_callback(struct i2c_ctx* ctx, i2cw_callback_t cb, void* user_data)
@@ -126,44 +778,53 @@ int i2cw_register_callback(struct i2c_ctx* ctx, i2cw_callback_t cb, void* user_d
     return 0;
 }
 
-int i2cw_async_write_read(struct i2c_ctx* ctx, const uint8_t* tx_buf, size_t tx_len, uint8_t* rx_buf, size_t rx_len)
+int i2cw_submit(struct i2c_ctx* ctx, uint16_t addr, const struct i2c_msg* msgs, uint8_t num_msgs, i2cw_callback_t cb, void* user_data)
 {
-    if (!ctx || !tx_buf || !rx_buf || tx_len == 0 || rx_len == 0) {
+    if (!ctx || !msgs || num_msgs == 0 || num_msgs > CONFIG_I2C_WRAPPER_TXN_MAX_MSGS) {
         return -EINVAL;
     }
 
-    /* prepare (persistent) message descriptors stored in ctx */
-    ctx->msgs[0].buf = (uint8_t*)tx_buf;
-    ctx->msgs[0].len = tx_len;
-    ctx->msgs[0].flags = I2C_MSG_WRITE;
+    k_spinlock_key_t key = k_spin_lock(&ctx->txn_lock);
 
-    ctx->msgs[1].buf = rx_buf;
-    ctx->msgs[1].len = rx_len;
-    ctx->msgs[1].flags = I2C_MSG_READ | I2C_MSG_STOP;
-
-    /* reset signal, store rx pointers for worker callback */
-    k_poll_signal_reset(&ctx->async_signal);
-    ctx->rx_buf = rx_buf;
-    ctx->rx_len = rx_len;
+    if (ctx->txn_count == CONFIG_I2C_WRAPPER_QUEUE_DEPTH) {
+        k_spin_unlock(&ctx->txn_lock, key);
+        return -ENOBUFS;
+    }
 
-    int ret = -ENOTSUP;
+    struct i2cw_txn* txn = &ctx->txn_queue[(ctx->txn_head + ctx->txn_count) % CONFIG_I2C_WRAPPER_QUEUE_DEPTH];
 
-#if defined(CONFIG_POLL)
-    /* Use signal variant (requires CONFIG_POLL) */
-    ret = i2c_transfer_signal(ctx->bus.bus, ctx->msgs, 2, ctx->bus.addr, &ctx->async_signal);
-#elif defined(CONFIG_I2C_CALLBACK)
-    /* Use callback variant (requires CONFIG_I2C_CALLBACK).
-     * We pass the k_poll_signal as userdata so our internal cb can raise it.
-     */
-    ret = i2c_transfer_cb(ctx->bus.bus, ctx->msgs, 2, ctx->bus.addr, (i2c_callback_t)i2cw_i2c_cb, &ctx->async_signal);
-#else
-    /* Neither CONFIG_POLL nor CONFIG_I2C_CALLBACK is enabled */
-    ret = -ENOTSUP;
+    memcpy(txn->msgs, msgs, num_msgs * sizeof(*msgs));
+    txn->num_msgs = num_msgs;
+    txn->addr = addr;
+    txn->cb = cb;
+    txn->user_data = user_data;
+    txn->attempts = 0;
+#if CONFIG_I2C_WRAPPER_TRACE
+    txn->t_submit = I2CW_TRACE_TS();
 #endif
+    ctx->txn_count++;
 
-    if (ret) {
-        LOG_ERR("Async transfer start failed (%d)", ret);
+    bool start = !ctx->txn_busy;
+    ctx->txn_busy = true;
+    k_spin_unlock(&ctx->txn_lock, key);
+
+    if (start) {
+        i2cw_txn_start(ctx);
     }
 
-    return ret;
-}
\ No newline at end of file
+    return 0;
+}
+
+int i2cw_async_write_read(struct i2c_ctx* ctx, const uint8_t* tx_buf, size_t tx_len, uint8_t* rx_buf, size_t rx_len)
+{
+    if (!ctx || !tx_buf || !rx_buf || tx_len == 0 || rx_len == 0) {
+        return -EINVAL;
+    }
+
+    const struct i2c_msg msgs[2] = {
+        {.buf = (uint8_t*)tx_buf, .len = tx_len, .flags = I2C_MSG_WRITE},
+        {.buf = rx_buf, .len = rx_len, .flags = I2C_MSG_READ | I2C_MSG_STOP},
+    };
+
+    return i2cw_submit(ctx, ctx->bus.addr, msgs, ARRAY_SIZE(msgs), ctx->callback, ctx->cb_user_data);
+}
@@ -15,6 +15,13 @@
 #include <zephyr/device.h>
 #include <zephyr/drivers/i2c.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include "i2c_trace.h"
+
+#if CONFIG_I2C_WRAPPER_ARBITER
+    #include "i2c_arbiter.h"
+#endif
 
 /**
  * @brief Async callback type.
@@ -26,35 +33,139 @@
  */
 typedef void (*i2cw_callback_t)(void* user_data, int result, uint8_t* buf, size_t len);
 
+/**
+ * @brief Payload segment for scatter-list writes.
+ */
+struct i2cw_seg
+{
+    const uint8_t* buf; /**< Segment data */
+    size_t len;         /**< Segment length */
+};
+
+/**
+ * @brief Queued I2C transaction.
+ *
+ * Message descriptors are copied into the queue on submit; the data buffers
+ * they point to must stay valid until the callback runs.
+ */
+struct i2cw_txn
+{
+    struct i2c_msg msgs[CONFIG_I2C_WRAPPER_TXN_MAX_MSGS]; /**< Message descriptors */
+    uint8_t num_msgs;                                     /**< Messages in use */
+    uint16_t addr;                                        /**< Target address */
+    i2cw_callback_t cb;                                   /**< Completion callback, may be NULL */
+    void* user_data;                                      /**< Passed back to @c cb */
+    uint8_t attempts;                                     /**< Retries done so far */
+#if CONFIG_I2C_WRAPPER_TRACE
+    uint32_t t_submit; /**< Trace timestamp of i2cw_submit() */
+    uint32_t t_start;  /**< Trace timestamp of the current attempt's start */
+#endif
+};
+
+/** @brief Callback tokens per context: the attempt on the bus and a timed-out one still owing its completion. */
+#define I2CW_XFER_TAGS 2
+
+struct i2c_ctx;
+
+/**
+ * @brief Driver callback token of one transfer attempt.
+ *
+ * Passed as user data to i2c_transfer_cb(). The slot stays taken until the
+ * driver calls back, so a late completion always reads its own generation.
+ */
+struct i2cw_xfer_tag
+{
+    struct i2c_ctx* ctx; /**< Owning context */
+    atomic_t gen;        /**< Generation of the attempt, 0 when the slot is free */
+};
+
+/**
+ * @brief Failure counters for one target address.
+ */
+struct i2cw_addr_stats
+{
+    uint16_t addr;     /**< Target address */
+    uint32_t failures; /**< Failed attempts */
+    uint32_t timeouts; /**< Attempts that hit the transfer deadline */
+    uint32_t retries;  /**< Attempts that were retried */
+};
+
+/**
+ * @brief Error and recovery counters of a context.
+ */
+struct i2cw_stats
+{
+    uint32_t failures;   /**< Failed attempts, all addresses */
+    uint32_t timeouts;   /**< Attempts that hit the transfer deadline */
+    uint32_t retries;    /**< Attempts that were retried */
+    uint32_t gave_up;    /**< Transactions that failed after all retries */
+    uint32_t recoveries; /**< i2c_recover_bus() calls */
+    uint8_t num_addr;    /**< Entries used in @c addr */
+    /** Per-address counters, the first CONFIG_I2C_WRAPPER_ADDR_STATS failing addresses */
+    struct i2cw_addr_stats addr[CONFIG_I2C_WRAPPER_ADDR_STATS];
+};
+
 /**
  * @brief I2C wrapper context.
  */
 struct i2c_ctx
 {
-    struct i2c_dt_spec bus;            /**< I2C bus specification (from DT) */
-    struct k_poll_signal async_signal; /**< Poll signal for async ops */
-    struct k_poll_event async_event;   /**< Poll event */
-    i2cw_callback_t callback;          /**< Completion callback */
-    void* cb_user_data;                /**< User context pointer */
+    struct i2c_dt_spec bus;   /**< I2C bus specification (from DT) */
+    i2cw_callback_t callback; /**< Completion callback */
+    void* cb_user_data;       /**< User context pointer */
+
+    /* Transaction queue, the head entry is on the bus while txn_busy is set */
+    struct i2cw_txn txn_queue[CONFIG_I2C_WRAPPER_QUEUE_DEPTH];
+    uint8_t txn_head;
+    uint8_t txn_count;
+    bool txn_busy;
+    struct k_spinlock txn_lock;
+
+    /* Deadline, retry and recovery state */
+    atomic_t xfer_active;               /**< Generation of the attempt on the bus, 0 if none */
+    uint32_t xfer_gen;                  /**< Generation of the last attempt started */
+    struct i2cw_xfer_tag xfer_tags[I2CW_XFER_TAGS];
+    bool recover_pending;               /**< Recover the bus before the next transfer */
+    bool recover_granted;               /**< Bus handed over for the pending recovery */
+    struct k_work_delayable retry_work; /**< Backoff and bus recovery */
+#if CONFIG_I2C_WRAPPER_TIMEOUT_MS > 0 && !CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+    struct k_work_delayable wdog; /**< Transfer deadline */
+#endif
+    struct i2cw_stats stats; /**< Error counters, protected by txn_lock */
 
-    /* Async transfer state */
-    uint8_t* rx_buf;
-    size_t rx_len;
+#if CONFIG_I2C_WRAPPER_ARBITER
+    struct i2cw_bus* arb;              /**< Bus arbiter, NULL if not attached */
+    struct i2cw_bus_waiter arb_waiter; /**< Waiter for queued transactions */
+    uint8_t arb_prio;                  /**< Priority class on the arbiter */
+#endif
 
-    /* Persistent messages buffer for async transfer (must live until transfer completes) */
-    struct i2c_msg msgs[2];
+#if CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+    struct k_poll_signal async_signal;   /**< Poll signal for async ops */
+    struct k_poll_signal kick_signal;    /**< Re-arms the worker's deadline after a transfer start */
+    struct k_poll_event async_events[2]; /**< Poll events for both signals */
+    k_timepoint_t deadline;              /**< Deadline of the transfer on the bus */
 
     /* Worker thread */
     struct k_thread worker_thread;
     k_thread_stack_t* worker_stack;
     size_t worker_stack_size;
     bool worker_running;
+#elif CONFIG_I2C_WRAPPER_COMPLETION_WORKQ
+    struct k_work done_work; /**< Completion item on the shared work queue */
+#endif
+#if !CONFIG_I2C_WRAPPER_COMPLETION_DIRECT
+    atomic_val_t done_gen; /**< Generation of the finished transfer */
+    int done_result;       /**< Result of the finished transfer */
+#endif
 };
 
 /* Blocking API */
 /**
  * @brief Initialize I2C wrapper from devicetree.
  *
+ * The worker thread arguments are only used with
+ * CONFIG_I2C_WRAPPER_COMPLETION_THREAD; pass NULL, 0, 0 otherwise.
+ *
  * @param ctx     Pointer to wrapper context
  * @param bus_dt  Devicetree I2C specification
  * @param stack   Pointer to thread stack memory
@@ -70,10 +181,17 @@ int i2cw_init(struct i2c_ctx* ctx, const struct i2c_dt_spec* bus_dt, k_thread_st
 /**
  * @brief Deinitialize I2C wrapper and stop worker thread.
  *
+ * Queued transactions are dropped without callbacks. A transfer already
+ * started is waited for, up to CONFIG_I2C_WRAPPER_TIMEOUT_MS, and then
+ * aborted with i2c_recover_bus(); the bus is only released afterwards.
+ * The buffers of started transfers stay in use until this returns, or
+ * until the driver completes them if it returns -ETIMEDOUT.
+ *
  * @param ctx Pointer to wrapper context
  *
  * @retval 0 On success
  * @retval -EINVAL If ctx is NULL
+ * @retval -ETIMEDOUT If the controller kept a transfer even after bus recovery
  */
 int i2cw_deinit(struct i2c_ctx* ctx);
 
@@ -115,6 +233,105 @@ int i2cw_read(struct i2c_ctx* ctx, uint8_t* buf, size_t len);
  */
 int i2cw_write_read(struct i2c_ctx* ctx, const uint8_t* tx_buf, size_t tx_len, uint8_t* rx_buf, size_t rx_len);
 
+/**
+ * @brief Transfer a caller-built message list to the context's device.
+ *
+ * @param ctx       Pointer to wrapper context
+ * @param msgs      Message list, the last message should carry I2C_MSG_STOP
+ * @param num_msgs  Number of messages
+ *
+ * @retval 0 On success
+ * @retval <0 Error code
+ */
+int i2cw_transfer(struct i2c_ctx* ctx, struct i2c_msg* msgs, uint8_t num_msgs);
+
+/**
+ * @brief Read @p len bytes starting at register @p reg in one transaction.
+ *
+ * Relies on the device auto-incrementing the register address.
+ *
+ * @param ctx   Pointer to wrapper context
+ * @param reg   First register address
+ * @param buf   Buffer to store read data
+ * @param len   Number of bytes to read
+ *
+ * @retval 0 On success
+ * @retval <0 Error code
+ */
+int i2cw_burst_read(struct i2c_ctx* ctx, uint8_t reg, uint8_t* buf, size_t len);
+
+/**
+ * @brief Write @p len bytes starting at register @p reg in one transaction.
+ *
+ * The register address and the payload are sent as two messages with no
+ * RESTART in between, so the payload is not copied behind the address.
+ *
+ * @param ctx   Pointer to wrapper context
+ * @param reg   First register address
+ * @param buf   Data to write
+ * @param len   Number of bytes to write
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If arguments invalid or the payload runs past register 0xff
+ * @retval <0 Error code
+ */
+int i2cw_burst_write(struct i2c_ctx* ctx, uint8_t reg, const uint8_t* buf, size_t len);
+
+/**
+ * @brief Scatter-list variant of i2cw_burst_write().
+ *
+ * Segments are sent back to back after the register address as one
+ * transaction.
+ *
+ * @param ctx   Pointer to wrapper context
+ * @param reg   First register address
+ * @param segs  Payload segments, written in order
+ * @param nsegs Number of segments, at most CONFIG_I2C_WRAPPER_BURST_MAX_SEGS
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If arguments invalid or the payload runs past register 0xff
+ * @retval <0 Error code
+ */
+int i2cw_burst_writev(struct i2c_ctx* ctx, uint8_t reg, const struct i2cw_seg* segs, size_t nsegs);
+
+/**
+ * @brief Copy the error and recovery counters.
+ *
+ * @param ctx   Wrapper context
+ * @param stats Destination
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If arguments invalid
+ */
+int i2cw_get_stats(struct i2c_ctx* ctx, struct i2cw_stats* stats);
+
+/**
+ * @brief Clear the error and recovery counters.
+ *
+ * @param ctx Wrapper context
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If ctx is NULL
+ */
+int i2cw_reset_stats(struct i2c_ctx* ctx);
+
+#if CONFIG_I2C_WRAPPER_ARBITER
+/**
+ * @brief Attach a context to a shared bus arbiter.
+ *
+ * Attach before any transfer is started. All contexts using the same bus
+ * device should attach to the same arbiter.
+ *
+ * @param ctx  Wrapper context
+ * @param bus  Arbiter for ctx->bus.bus, NULL to detach
+ * @param prio Priority class of this context's transactions
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If arguments invalid or the arbiter is for another bus
+ */
+int i2cw_attach_bus(struct i2c_ctx* ctx, struct i2cw_bus* bus, enum i2cw_prio prio);
+#endif
+
 /* Async API */
 /**
  * @brief Configure callback for async transfers.
@@ -134,11 +351,42 @@ int i2cw_register_callback(struct i2c_ctx* ctx, i2cw_callback_t cb, void* user_d
  * @param rx_buf  Buffer to receive data
  * @param rx_len  Number of bytes to receive
  *
- * Callback is invoked when transfer completes.
+ * The transaction is queued behind any already submitted ones and the
+ * registered callback is invoked when it completes.
  *
  * @retval 0 On success
+ * @retval -ENOBUFS If the transaction queue is full
  * @retval <0 Error code
  */
 int i2cw_async_write_read(struct i2c_ctx* ctx, const uint8_t* tx_buf, size_t tx_len, uint8_t* rx_buf, size_t rx_len);
 
+/**
+ * @brief Queue an asynchronous transaction.
+ *
+ * Each attempt has a deadline of CONFIG_I2C_WRAPPER_TIMEOUT_MS. Failed or
+ * timed out attempts are retried up to CONFIG_I2C_WRAPPER_RETRIES times
+ * with exponential backoff, recovering the bus first after -EIO or
+ * -ETIMEDOUT; the callback sees the result of the last attempt.
+ *
+ * Transactions run in submission order. When one completes the next queued
+ * one is started before the completion callback runs, so the bus does not
+ * idle while callbacks run. The callback runs in the worker thread, on the
+ * shared work queue, or in the driver's completion context (usually an ISR)
+ * depending on the CONFIG_I2C_WRAPPER_COMPLETION_* choice. The callback
+ * receives the buffer and length of the last read message, or of the last
+ * message if there is no read.
+ *
+ * @param ctx       Wrapper context
+ * @param addr      Target address
+ * @param msgs      Message descriptors, copied into the queue
+ * @param num_msgs  Number of messages, at most CONFIG_I2C_WRAPPER_TXN_MAX_MSGS
+ * @param cb        Completion callback, may be NULL
+ * @param user_data Pointer passed back to @p cb
+ *
+ * @retval 0 On success
+ * @retval -ENOBUFS If the transaction queue is full
+ * @retval -EINVAL If arguments invalid
+ */
+int i2cw_submit(struct i2c_ctx* ctx, uint16_t addr, const struct i2c_msg* msgs, uint8_t num_msgs, i2cw_callback_t cb, void* user_data);
+
 #endif  // I2C_WRAPPER_H_
\ No newline at end of file
@@ -0,0 +1,231 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include "uart_framer.h"
+#include "uart_wrapper.h"
+
+LOG_MODULE_DECLARE(uart_wrp, CONFIG_UART_WRAPPER_LOG_LEVEL);
+
+#define SLIP_END     0xC0
+#define SLIP_ESC     0xDB
+#define SLIP_ESC_END 0xDC
+#define SLIP_ESC_ESC 0xDD
+
+#define ONES  0x01010101U
+#define HIGHS 0x80808080U
+
+/* Find @p c in @p p, testing four bytes per step once the pointer is aligned. */
+static uint8_t* uaw_find_byte(uint8_t* p, size_t len, uint8_t c)
+{
+    uint8_t* end = p + len;
+
+    while (p < end && ((uintptr_t)p & (sizeof(uint32_t) - 1))) {
+        if (*p == c) {
+            return p;
+        }
+        p++;
+    }
+
+    const uint32_t pattern = ONES * c;
+
+    while (end - p >= (ptrdiff_t)sizeof(uint32_t)) {
+        uint32_t w;
+
+        memcpy(&w, p, sizeof(w));
+        w ^= pattern;
+        /* Non-zero if any byte of w is zero, i.e. matched c */
+        if ((w - ONES) & ~w & HIGHS) {
+            break;
+        }
+        p += sizeof(uint32_t);
+    }
+
+    while (p < end) {
+        if (*p == c) {
+            return p;
+        }
+        p++;
+    }
+    return NULL;
+}
+
+static int uaw_cobs_decode(uint8_t* buf, size_t len)
+{
+    size_t r = 0;
+    size_t w = 0;
+
+    while (r < len) {
+        uint8_t code = buf[r++];
+
+        if (code == 0 || r + code - 1 > len) {
+            return -EINVAL;
+        }
+        for (uint8_t i = 1; i < code; i++) {
+            buf[w++] = buf[r++];
+        }
+        if (code != 0xFF && r < len) {
+            buf[w++] = 0;
+        }
+    }
+    return (int)w;
+}
+
+static int uaw_slip_decode(uint8_t* buf, size_t len)
+{
+    size_t w = 0;
+
+    for (size_t r = 0; r < len; r++) {
+        if (buf[r] != SLIP_ESC) {
+            buf[w++] = buf[r];
+            continue;
+        }
+        if (++r == len) {
+            return -EINVAL;
+        }
+        if (buf[r] == SLIP_ESC_END) {
+            buf[w++] = SLIP_END;
+        }
+        else if (buf[r] == SLIP_ESC_ESC) {
+            buf[w++] = SLIP_ESC;
+        }
+        else {
+            return -EINVAL;
+        }
+    }
+    return (int)w;
+}
+
+static void uaw_framer_deliver(struct uart_ctx* ctx, struct uaw_framer* fr, uint8_t* frame, size_t len)
+{
+    int n = (int)len;
+
+    if (len == 0) {
+        return;
+    }
+
+    if (fr->mode == UAW_FRAME_COBS) {
+        n = uaw_cobs_decode(frame, len);
+    }
+    else if (fr->mode == UAW_FRAME_SLIP) {
+        n = uaw_slip_decode(frame, len);
+    }
+
+    if (n < 0) {
+        fr->errors++;
+        return;
+    }
+
+    fr->frames++;
+    fr->cb(ctx, frame, n, fr->user_data);
+}
+
+/* Append to the partial frame. Returns false once the frame overflowed. */
+static bool uaw_framer_append(struct uaw_framer* fr, const uint8_t* data, size_t len)
+{
+    if (fr->overflow) {
+        return false;
+    }
+    if (len > fr->scratch_len - fr->fill) {
+        fr->overflow = true;
+        fr->errors++;
+        return false;
+    }
+    memcpy(fr->scratch + fr->fill, data, len);
+    fr->fill += len;
+    return true;
+}
+
+/* Finish the current frame, which ends with @p data[0..len). */
+static void uaw_framer_end(struct uart_ctx* ctx, struct uaw_framer* fr, uint8_t* data, size_t len)
+{
+    if (fr->fill == 0 && !fr->overflow) {
+        /* Whole frame is inside this chunk: hand out a view of the RX buffer */
+        uaw_framer_deliver(ctx, fr, data, len);
+    }
+    else if (uaw_framer_append(fr, data, len)) {
+        uaw_framer_deliver(ctx, fr, fr->scratch, fr->fill);
+    }
+    fr->fill = 0;
+    fr->overflow = false;
+}
+
+void uaw_framer_feed(struct uart_ctx* ctx, struct uaw_framer* fr, uint8_t* data, size_t len, bool idle)
+{
+    if (fr->mode == UAW_FRAME_IDLE) {
+        if (idle) {
+            uaw_framer_end(ctx, fr, data, len);
+        }
+        else {
+            (void)uaw_framer_append(fr, data, len);
+        }
+        return;
+    }
+
+    while (len) {
+        uint8_t* end = uaw_find_byte(data, len, fr->delim);
+
+        if (!end) {
+            (void)uaw_framer_append(fr, data, len);
+            return;
+        }
+
+        size_t n = end - data;
+
+        uaw_framer_end(ctx, fr, data, n);
+        data += n + 1;
+        len -= n + 1;
+    }
+}
+
+int uaw_framer_init(struct uaw_framer* fr, enum uaw_frame_mode mode, uint8_t delim, uint8_t* scratch, size_t scratch_len, uaw_frame_cb_t cb,
+                    void* user_data)
+{
+    if (!fr || !scratch || !scratch_len || !cb) {
+        return -EINVAL;
+    }
+
+    memset(fr, 0, sizeof(*fr));
+    fr->mode = mode;
+    switch (mode) {
+    case UAW_FRAME_COBS:
+        fr->delim = 0x00;
+        break;
+    case UAW_FRAME_SLIP:
+        fr->delim = SLIP_END;
+        break;
+    default:
+        fr->delim = delim;
+        break;
+    }
+    fr->scratch = scratch;
+    fr->scratch_len = scratch_len;
+    fr->cb = cb;
+    fr->user_data = user_data;
+    return 0;
+}
+
+int uaw_framer_attach(struct uart_ctx* ctx, struct uaw_framer* fr)
+{
+    if (!ctx) {
+        return -EINVAL;
+    }
+    if (fr && fr->mode == UAW_FRAME_IDLE && ctx->backend != UAW_BACKEND_ASYNC) {
+        return -ENOTSUP;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+    if (fr) {
+        fr->fill = 0;
+        fr->overflow = false;
+    }
+    ctx->framer = fr;
+    k_spin_unlock(&ctx->lock, key);
+
+    return 0;
+}
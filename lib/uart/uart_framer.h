@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file uart_framer.h
+ * @brief Frame delimiting layer for the UART wrapper.
+ *
+ * Splits the received byte stream into frames and hands each frame to a
+ * callback as a (pointer, length) view. A frame that lies completely inside
+ * one received chunk is delivered straight from the RX buffer without a copy.
+ * Only frames spanning several chunks are assembled in a scratch buffer.
+ */
+
+#ifndef UART_FRAMER_H_
+#define UART_FRAMER_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct uart_ctx;
+
+/**
+ * @brief Frame callback type.
+ *
+ * Called from the UART ISR for every complete, decoded frame. The frame
+ * memory is only valid for the duration of the call.
+ *
+ * @param ctx UART context pointer.
+ * @param frame Pointer to the frame payload, without delimiter.
+ * @param len Length of the frame payload.
+ * @param user_data User-provided context.
+ */
+typedef void (*uaw_frame_cb_t)(struct uart_ctx* ctx, const uint8_t* frame, size_t len, void* user_data);
+
+/**
+ * @brief Framing mode.
+ */
+enum uaw_frame_mode {
+    UAW_FRAME_DELIMITER, /**< Frames end with a configurable delimiter byte */
+    UAW_FRAME_COBS,      /**< COBS encoded frames terminated by 0x00 */
+    UAW_FRAME_SLIP,      /**< SLIP (RFC 1055) frames terminated by END */
+    UAW_FRAME_IDLE,      /**< A frame ends when the line goes idle (async backend only) */
+};
+
+/**
+ * @brief Framer state.
+ */
+struct uaw_framer
+{
+    enum uaw_frame_mode mode; /**< Framing mode */
+    uint8_t delim;            /**< Delimiter byte */
+
+    uint8_t* scratch;   /**< Buffer for frames spanning several RX chunks */
+    size_t scratch_len; /**< Scratch buffer size */
+    size_t fill;        /**< Bytes of a partial frame in scratch */
+    bool overflow;      /**< Partial frame did not fit and is being discarded */
+
+    uaw_frame_cb_t cb; /**< Frame callback */
+    void* user_data;   /**< User context */
+
+    uint32_t frames; /**< Frames delivered */
+    uint32_t errors; /**< Frames dropped on overflow or decode error */
+};
+
+/**
+ * @brief Initialize a framer.
+ *
+ * COBS and SLIP payloads are decoded in place before delivery.
+ *
+ * @param fr Framer pointer.
+ * @param mode Framing mode.
+ * @param delim Delimiter byte for UAW_FRAME_DELIMITER, ignored otherwise.
+ * @param scratch Scratch buffer, must hold the longest expected frame.
+ * @param scratch_len Scratch buffer size.
+ * @param cb Frame callback.
+ * @param user_data User context.
+ * @return 0 on success, -EINVAL on invalid arguments.
+ */
+int uaw_framer_init(struct uaw_framer* fr, enum uaw_frame_mode mode, uint8_t delim, uint8_t* scratch, size_t scratch_len, uaw_frame_cb_t cb,
+                    void* user_data);
+
+/**
+ * @brief Attach a framer to a UART context.
+ *
+ * Received data keeps flowing into the RX ring and rx_cb as before.
+ *
+ * @param ctx UART context pointer.
+ * @param fr Framer, NULL to detach.
+ * @return 0 on success, -ENOTSUP for UAW_FRAME_IDLE on the IRQ backend.
+ */
+int uaw_framer_attach(struct uart_ctx* ctx, struct uaw_framer* fr);
+
+/**
+ * @internal
+ * @brief Feed received bytes to a framer. Called by the wrapper from ISR.
+ *
+ * @param ctx UART context pointer.
+ * @param fr Framer pointer.
+ * @param data Received bytes, may be modified by in-place decoding.
+ * @param len Number of received bytes.
+ * @param idle True if the chunk ended because the line went idle.
+ */
+void uaw_framer_feed(struct uart_ctx* ctx, struct uaw_framer* fr, uint8_t* data, size_t len, bool idle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
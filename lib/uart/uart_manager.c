@@ -0,0 +1,200 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include "uart_manager.h"
+
+LOG_MODULE_DECLARE(uart_wrp, CONFIG_UART_WRAPPER_LOG_LEVEL);
+
+static void uaw_mgr_kick(struct uaw_mgr* mgr)
+{
+    if (mgr->workq) {
+        (void)k_work_submit_to_queue(mgr->workq, &mgr->work);
+    }
+    else {
+        (void)k_work_submit(&mgr->work);
+    }
+}
+
+void uaw_mgr_port_tx_space(struct uaw_mgr_port* port)
+{
+    /* Space freed on this port, let the scheduler refill it */
+    uaw_mgr_kick(port->mgr);
+}
+
+/* Move the head of @p port->pending to @p out. Caller holds mgr->lock. */
+static struct tx_node* uaw_mgr_pop(struct uaw_mgr_port* port, struct uaw_tx_chain* out)
+{
+    struct tx_node* node = port->pending.head;
+
+    port->pending.head = node->fifo_reserved;
+    if (!port->pending.head) {
+        port->pending.tail = NULL;
+    }
+    port->pending_bytes -= node->len;
+
+    node->fifo_reserved = NULL;
+    if (out->tail) {
+        out->tail->fifo_reserved = node;
+    }
+    else {
+        out->head = node;
+    }
+    out->tail = node;
+    return node;
+}
+
+static void uaw_mgr_work_handler(struct k_work* work)
+{
+    struct uaw_mgr* mgr = CONTAINER_OF(work, struct uaw_mgr, work);
+    struct uaw_tx_chain grant[CONFIG_UART_WRAPPER_MANAGER_MAX_PORTS] = {0};
+    bool again = false;
+
+    k_spinlock_key_t key = k_spin_lock(&mgr->lock);
+
+    for (size_t i = 0; i < mgr->num_ports; i++) {
+        uint8_t idx = mgr->order[i];
+        struct uaw_mgr_port* port = &mgr->ports[idx];
+        size_t inflight = uaw_tx_queued_bytes(port->ctx);
+
+        if (!port->pending.head) {
+            port->deficit = 0;
+            continue;
+        }
+
+        /* Cap the carried budget so a port cannot save up a burst, but always
+         * let it grow enough to pass a heap node larger than the quantum */
+        port->deficit = MIN(port->deficit + port->quantum, MAX(2 * port->quantum, port->pending.head->len));
+
+        struct tx_node* node;
+        while ((node = port->pending.head) != NULL && node->len <= port->deficit && inflight + node->len <= port->inflight_max) {
+            uaw_mgr_pop(port, &grant[idx]);
+            port->deficit -= node->len;
+            inflight += node->len;
+        }
+
+        /* Head does not fit the budget yet: run another round to top it up. A
+         * port held back by inflight_max is kicked by uaw_mgr_port_tx_space() */
+        if (port->pending.head && port->pending.head->len > port->deficit) {
+            again = true;
+        }
+    }
+
+    k_spin_unlock(&mgr->lock, key);
+
+    for (size_t i = 0; i < mgr->num_ports; i++) {
+        uint8_t idx = mgr->order[i];
+
+        uaw_tx_chain_submit(mgr->ports[idx].ctx, &grant[idx]);
+    }
+
+    if (again) {
+        uaw_mgr_kick(mgr);
+    }
+}
+
+int uaw_mgr_init(struct uaw_mgr* mgr, struct k_work_q* workq)
+{
+    if (!mgr) {
+        return -EINVAL;
+    }
+
+    memset(mgr, 0, sizeof(*mgr));
+    mgr->workq = workq;
+    k_work_init(&mgr->work, uaw_mgr_work_handler);
+    return 0;
+}
+
+int uaw_mgr_add_port(struct uaw_mgr* mgr, struct uart_ctx* ctx, uint8_t prio, size_t quantum, size_t inflight_max)
+{
+    if (!mgr || !ctx || !quantum || !inflight_max) {
+        return -EINVAL;
+    }
+    if (ctx->tx_slab && quantum < ctx->tx_node_payload) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&mgr->lock);
+
+    if (mgr->num_ports == ARRAY_SIZE(mgr->ports)) {
+        k_spin_unlock(&mgr->lock, key);
+        return -ENOMEM;
+    }
+
+    size_t idx = mgr->num_ports++;
+    struct uaw_mgr_port* port = &mgr->ports[idx];
+
+    port->mgr = mgr;
+    port->ctx = ctx;
+    port->prio = prio;
+    port->quantum = quantum;
+    port->inflight_max = inflight_max;
+    ctx->mgr_port = port;
+
+    /* Keep order[] sorted by priority; equal priorities keep insertion order */
+    size_t pos = idx;
+    while (pos > 0 && mgr->ports[mgr->order[pos - 1]].prio > prio) {
+        mgr->order[pos] = mgr->order[pos - 1];
+        pos--;
+    }
+    mgr->order[pos] = idx;
+
+    k_spin_unlock(&mgr->lock, key);
+    return (int)idx;
+}
+
+int uaw_mgr_write(struct uaw_mgr* mgr, int port, const void* data, size_t len)
+{
+    if (!mgr || port < 0 || (size_t)port >= mgr->num_ports || !data || len == 0) {
+        return -EINVAL;
+    }
+
+    struct uaw_mgr_port* p = &mgr->ports[port];
+    struct uaw_tx_chain chain = {0};
+    const struct uaw_iovec iov = {.base = data, .len = len};
+
+    int rc = uaw_tx_chain_build(p->ctx, &iov, 1, SIZE_MAX, &chain);
+    if (rc) {
+        uaw_tx_chain_free(p->ctx, &chain);
+        return rc;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&mgr->lock);
+    if (p->pending.tail) {
+        p->pending.tail->fifo_reserved = chain.head;
+    }
+    else {
+        p->pending.head = chain.head;
+    }
+    p->pending.tail = chain.tail;
+    p->pending_bytes += len;
+    k_spin_unlock(&mgr->lock, key);
+
+    uaw_mgr_kick(mgr);
+    return 0;
+}
+
+int uaw_mgr_flush(struct uaw_mgr* mgr, int port)
+{
+    if (!mgr || port < 0 || (size_t)port >= mgr->num_ports) {
+        return -EINVAL;
+    }
+
+    struct uaw_mgr_port* p = &mgr->ports[port];
+
+    k_spinlock_key_t key = k_spin_lock(&mgr->lock);
+    struct uaw_tx_chain chain = p->pending;
+    p->pending.head = NULL;
+    p->pending.tail = NULL;
+    p->pending_bytes = 0;
+    p->deficit = 0;
+    k_spin_unlock(&mgr->lock, key);
+
+    uaw_tx_chain_free(p->ctx, &chain);
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file uart_manager.h
+ * @brief Shared TX scheduler for several UART wrapper contexts.
+ *
+ * The manager owns a set of uart_ctx ports. Writes go to a per-port software
+ * queue and a single work item moves them to the ports. Ports are visited in
+ * priority order and each gets a byte budget per round (deficit round robin),
+ * so a chatty port cannot starve the others. TX nodes come from each port's
+ * own allocator, so with a pool set via uaw_tx_pool_set() the scheduler never
+ * touches the heap.
+ */
+
+#ifndef UART_MANAGER_H_
+#define UART_MANAGER_H_
+
+#include <zephyr/kernel.h>
+
+#include "uart_wrapper.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Manager port.
+ */
+struct uaw_mgr_port
+{
+    struct uaw_mgr* mgr;         /**< Owning manager */
+    struct uart_ctx* ctx;        /**< UART context of this port */
+    uint8_t prio;                /**< Priority, 0 is served first */
+    size_t quantum;              /**< Bytes granted per scheduler round */
+    size_t deficit;              /**< Budget carried over from earlier rounds */
+    size_t inflight_max;         /**< Bytes allowed in the port TX queue at once */
+    struct uaw_tx_chain pending; /**< Writes waiting for the scheduler */
+    size_t pending_bytes;        /**< Bytes in @c pending */
+};
+
+/**
+ * @brief UART manager.
+ */
+struct uaw_mgr
+{
+    struct uaw_mgr_port ports[CONFIG_UART_WRAPPER_MANAGER_MAX_PORTS]; /**< Ports */
+    uint8_t order[CONFIG_UART_WRAPPER_MANAGER_MAX_PORTS];             /**< Port indices sorted by priority */
+    size_t num_ports;                                                 /**< Ports in use */
+    struct k_work_q* workq;                                           /**< Scheduler work queue, NULL for the system one */
+    struct k_work work;                                               /**< Scheduler work item */
+    struct k_spinlock lock;                                           /**< Protects the port queues */
+};
+
+/**
+ * @brief Initialize a UART manager.
+ *
+ * @param mgr Manager pointer.
+ * @param workq Work queue running the scheduler, NULL for the system work queue.
+ * @return 0 on success, -EINVAL on invalid arguments.
+ */
+int uaw_mgr_init(struct uaw_mgr* mgr, struct k_work_q* workq);
+
+/**
+ * @brief Add an initialized UART context as a manager port.
+ *
+ * The context keeps its own tx_done_cb. The wrapper tells the manager
+ * about every retired TX node so partly sent writes keep flowing.
+ *
+ * @param mgr Manager pointer.
+ * @param ctx Initialized UART context.
+ * @param prio Port priority, 0 is served first.
+ * @param quantum Bytes the port may move per scheduler round, at least one
+ *                TX node payload.
+ * @param inflight_max Bytes the port may have queued in its context at once.
+ * @return Port index on success, -ENOMEM if all ports are used,
+ *         -EINVAL on invalid arguments.
+ */
+int uaw_mgr_add_port(struct uaw_mgr* mgr, struct uart_ctx* ctx, uint8_t prio, size_t quantum, size_t inflight_max);
+
+/**
+ * @brief Queue data on a manager port.
+ *
+ * Data is copied into TX nodes of the port's allocator immediately and sent
+ * when the scheduler grants the port budget.
+ *
+ * @param mgr Manager pointer.
+ * @param port Port index returned by uaw_mgr_add_port().
+ * @param data Data to send.
+ * @param len Length of data.
+ * @return 0 on success, -ENOMEM if no TX node is available,
+ *         -EINVAL on invalid arguments.
+ */
+int uaw_mgr_write(struct uaw_mgr* mgr, int port, const void* data, size_t len);
+
+/**
+ * @brief Drop everything still waiting in a port's software queue.
+ *
+ * @param mgr Manager pointer.
+ * @param port Port index.
+ * @return 0 on success, -EINVAL on invalid arguments.
+ */
+int uaw_mgr_flush(struct uaw_mgr* mgr, int port);
+
+/**
+ * @internal
+ * @brief Called by the wrapper when a TX transfer of a managed port retires.
+ */
+void uaw_mgr_port_tx_space(struct uaw_mgr_port* port);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
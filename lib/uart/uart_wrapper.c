@@ -12,53 +12,506 @@
 #include <zephyr/sys/ring_buffer.h>
 
 #include "uart_wrapper.h"
+#if CONFIG_UART_WRAPPER_MANAGER
+    #include "uart_manager.h"
+#endif
+#if CONFIG_UART_WRAPPER_FRAMING
+    #include "uart_framer.h"
+    #define UAW_FRAMER(ctx) ((ctx)->framer)
+#else
+    #define UAW_FRAMER(ctx) NULL
+#endif
 
 LOG_MODULE_REGISTER(uart_wrp, CONFIG_UART_WRAPPER_LOG_LEVEL);
 
-#if CONFIG_UART_ASYNC_API
-static void uaw_uart_cb(const struct device* dev, struct uart_event* evt, void* user_data)
+#if CONFIG_UART_WRAPPER_STATS
+BUILD_ASSERT(UAW_ISR_RX_STOPPED == (int)UART_RX_STOPPED, "uaw_isr_evt must follow uart_event_type");
+
+static inline void uaw_stat_isr(struct uart_ctx* ctx, enum uaw_isr_evt evt)
+{
+    ctx->stats.isr_events[evt]++;
+}
+
+static inline void uaw_stat_latency(struct uart_ctx* ctx, uint32_t t_enq)
+{
+    uint32_t bucket = find_msb_set(k_cycle_get_32() - t_enq);
+
+    ctx->stats.tx_latency_hist[MIN(bucket, CONFIG_UART_WRAPPER_STATS_LAT_BUCKETS - 1)]++;
+}
+
+static inline void uaw_stat_rx(struct uart_ctx* ctx, size_t len)
+{
+    ctx->stats.bytes_in += len;
+    if (ctx->rx_ring.size) {
+        ctx->stats.rx_ring_hwm = MAX(ctx->stats.rx_ring_hwm, ring_buf_size_get(&ctx->rx_ring));
+    }
+}
+#else
+    #define uaw_stat_isr(ctx, evt)         ((void)0)
+    #define uaw_stat_rx(ctx, len)          ((void)0)
+#endif
+
+static struct tx_node* uaw_tx_node_alloc(struct uart_ctx* ctx, size_t len)
 {
-    struct uart_ctx* ctx = (struct uart_ctx*)user_data;
     struct tx_node* node;
-    int rc;
 
-    switch (evt->type) {
-    case UART_TX_DONE:
-        if (ctx->tx_pending) {
-            k_free(ctx->tx_pending);
-            ctx->tx_pending = NULL;
+    if (ctx->tx_slab) {
+        if (k_mem_slab_alloc(ctx->tx_slab, (void**)&node, K_NO_WAIT) != 0) {
+            return NULL;
+        }
+        node->flags = UAW_TX_NODE_F_POOL;
+    }
+    else {
+        node = k_malloc(sizeof(struct tx_node) + len);
+        if (!node) {
+            return NULL;
+        }
+        node->flags = 0;
+    }
+    node->buf = node->data;
+    node->len = len;
+    return node;
+}
+
+static void uaw_tx_node_free(struct uart_ctx* ctx, struct tx_node* node)
+{
+    if (node->flags & UAW_TX_NODE_F_POOL) {
+        k_mem_slab_free(ctx->tx_slab, node);
+    }
+    else {
+        k_free(node);
+    }
+}
+
+#define UAW_WM_ACT_HIGH BIT(0)
+#define UAW_WM_ACT_LOW  BIT(1)
+#define UAW_WM_ACT_WAKE BIT(2)
+
+/* Account @p bytes leaving the TX queue. Caller holds ctx->lock. */
+static void uaw_tx_bytes_done(struct uart_ctx* ctx, size_t bytes)
+{
+    ctx->tx_queued_bytes -= MIN(bytes, ctx->tx_queued_bytes);
+
+    if (ctx->tx_above_wm && ctx->tx_queued_bytes <= ctx->tx_low_wm) {
+        ctx->tx_above_wm = false;
+        ctx->tx_wm_actions |= UAW_WM_ACT_LOW;
+    }
+    if (!ctx->tx_above_wm && ctx->tx_waiters) {
+        ctx->tx_wm_actions |= UAW_WM_ACT_WAKE;
+    }
+}
+
+/* Release ctx->lock, then run the watermark actions collected while holding it. */
+static void uaw_tx_unlock(struct uart_ctx* ctx, k_spinlock_key_t key)
+{
+    uint8_t act = ctx->tx_wm_actions;
+    uaw_tx_wm_cb_t cb = ctx->tx_wm_cb;
+
+    ctx->tx_wm_actions = 0;
+    k_spin_unlock(&ctx->lock, key);
+
+    if (act & UAW_WM_ACT_WAKE) {
+        k_sem_give(&ctx->tx_space_sem);
+    }
+    if (cb && (act & (UAW_WM_ACT_HIGH | UAW_WM_ACT_LOW))) {
+        cb(ctx, (act & UAW_WM_ACT_HIGH) != 0, ctx->user_data);
+    }
+}
+
+static void uaw_tx_chain_append(struct uaw_tx_chain* chain, struct tx_node* node)
+{
+    node->fifo_reserved = NULL;
+    if (chain->tail) {
+        chain->tail->fifo_reserved = node;
+    }
+    else {
+        chain->head = node;
+    }
+    chain->tail = node;
+}
+
+void uaw_tx_chain_free(struct uart_ctx* ctx, struct uaw_tx_chain* chain)
+{
+    while (chain->head) {
+        struct tx_node* next = chain->head->fifo_reserved;
+        uaw_tx_node_free(ctx, chain->head);
+        chain->head = next;
+    }
+    chain->tail = NULL;
+}
+
+/* Copy @p total bytes from @p iov, starting at segment *seg / offset *off. */
+static void uaw_iov_gather(uint8_t* dst, size_t total, const struct uaw_iovec* iov, size_t* seg, size_t* off)
+{
+    while (total) {
+        size_t n = MIN(total, iov[*seg].len - *off);
+
+        memcpy(dst, (const uint8_t*)iov[*seg].base + *off, n);
+        dst += n;
+        total -= n;
+        *off += n;
+        if (*off == iov[*seg].len) {
+            (*seg)++;
+            *off = 0;
+        }
+    }
+}
+
+/* Turn @p iov into TX nodes. Segments of at least @p zc_min bytes are
+ * borrowed, runs of smaller segments are copied into as few nodes as the
+ * allocator allows.
+ */
+int uaw_tx_chain_build(struct uart_ctx* ctx, const struct uaw_iovec* iov, size_t iovcnt, size_t zc_min, struct uaw_tx_chain* chain)
+{
+    size_t i = 0;
+
+    while (i < iovcnt) {
+        struct tx_node* node;
+
+        if (iov[i].len == 0) {
+            i++;
+            continue;
+        }
+
+        if (iov[i].len >= zc_min) {
+            node = uaw_tx_node_alloc(ctx, 0);
+            if (!node) {
+                return -ENOMEM;
+            }
+            node->flags |= UAW_TX_NODE_F_BORROWED;
+            node->buf = iov[i].base;
+            node->len = iov[i].len;
+            uaw_tx_chain_append(chain, node);
+            i++;
+            continue;
+        }
+
+        size_t end = i;
+        size_t total = 0;
+
+        while (end < iovcnt && iov[end].len < zc_min) {
+            total += iov[end].len;
+            end++;
+        }
+
+        /* Pooled nodes have a fixed payload, so large runs are split. */
+        size_t chunk_max = ctx->tx_slab ? ctx->tx_node_payload : total;
+        size_t seg = i;
+        size_t off = 0;
+
+        while (total) {
+            size_t chunk = MIN(chunk_max, total);
+
+            node = uaw_tx_node_alloc(ctx, chunk);
+            if (!node) {
+                return -ENOMEM;
+            }
+            uaw_iov_gather(node->data, chunk, iov, &seg, &off);
+            uaw_tx_chain_append(chain, node);
+            total -= chunk;
         }
-        node = k_fifo_get(&ctx->tx_fifo, K_NO_WAIT);
-        if (node) {
-            rc = uart_tx(dev, node->data, node->len, SYS_FOREVER_US);
+        i = end;
+    }
+
+    if (chain->tail) {
+        chain->tail->flags |= UAW_TX_NODE_F_LAST;
+    }
+
+    return 0;
+}
+
+#if CONFIG_UART_WRAPPER_TX_COALESCE_SIZE > 0
+/* Merge @p first and as many following queued nodes as fit into the staging
+ * buffer and send them as one transfer. Returns false, leaving @p first
+ * untouched, when the next node does not fit. If the driver refuses the
+ * transfer, the writes completed by the merged nodes are added to @p dropped.
+ * Caller holds ctx->lock.
+ */
+static bool uaw_tx_coalesce(struct uart_ctx* ctx, struct tx_node* first, size_t* dropped)
+{
+    struct tx_node* next = k_fifo_peek_head(&ctx->tx_fifo);
+
+    if (!next || first->len + next->len > sizeof(ctx->tx_stage)) {
+        return false;
+    }
+
+    size_t used = first->len;
+    size_t count = 1;
+    size_t writes = (first->flags & UAW_TX_NODE_F_LAST) ? 1 : 0;
+#if CONFIG_UART_WRAPPER_STATS
+    uint32_t t_enq = first->t_enq;
+#endif
+
+    memcpy(ctx->tx_stage, first->buf, first->len);
+    uaw_tx_node_free(ctx, first);
+
+    while ((next = k_fifo_peek_head(&ctx->tx_fifo)) != NULL && used + next->len <= sizeof(ctx->tx_stage)) {
+        next = k_fifo_get(&ctx->tx_fifo, K_NO_WAIT);
+        memcpy(ctx->tx_stage + used, next->buf, next->len);
+        used += next->len;
+        count++;
+        writes += (next->flags & UAW_TX_NODE_F_LAST) ? 1 : 0;
+        uaw_tx_node_free(ctx, next);
+    }
+
+    int rc = uart_tx(ctx->uart, ctx->tx_stage, used, SYS_FOREVER_US);
+    if (rc) {
+        LOG_ERR("uart_tx failed rc=%d, dropped %u writes", rc, (unsigned int)writes);
+        uaw_tx_bytes_done(ctx, used);
+        *dropped += writes;
+        return true;
+    }
+
+    ctx->tx_stage_nodes = count;
+    ctx->tx_stage_writes = writes;
+    ctx->tx_stage_len = used;
+#if CONFIG_UART_WRAPPER_STATS
+    ctx->tx_stage_t_enq = t_enq;
+#endif
+    ctx->stats.tx_transfers++;
+    ctx->stats.tx_coalesced_nodes += count;
+    ctx->stats.tx_irqs_saved += count - 1;
+    return true;
+}
+#endif
+
+/* Producer side of the RX ring, ISR context only. */
+static void uaw_rx_push(struct uart_ctx* ctx, const uint8_t* data, size_t len)
+{
+    if (!ctx->rx_ring.size) {
+        return;
+    }
+
+    uint32_t written = ring_buf_put(&ctx->rx_ring, data, len);
+    if (written < len) {
+        ctx->stats.rx_dropped += len - written;
+    }
+}
+
+/* Start the next queued node if nothing is in flight. Returns the number of
+ * writes whose last node the driver refused; they still get tx_done_cb so the
+ * caller can reuse borrowed memory. Caller holds ctx->lock.
+ */
+static size_t uaw_tx_start_next(struct uart_ctx* ctx)
+{
+    struct tx_node* node;
+    size_t dropped = 0;
+
+    while (!ctx->tx_pending && !ctx->tx_stage_nodes && (node = k_fifo_get(&ctx->tx_fifo, K_NO_WAIT)) != NULL) {
+#if CONFIG_UART_ASYNC_API
+        if (ctx->backend == UAW_BACKEND_ASYNC) {
+    #if CONFIG_UART_WRAPPER_TX_COALESCE_SIZE > 0
+            if (uaw_tx_coalesce(ctx, node, &dropped)) {
+                continue;
+            }
+    #endif
+            int rc = uart_tx(ctx->uart, node->buf, node->len, SYS_FOREVER_US);
             if (rc) {
                 LOG_ERR("uart_tx failed rc=%d", rc);
-                k_free(node);
-            }
-            else {
-                ctx->tx_pending = node;
+                uaw_tx_bytes_done(ctx, node->len);
+                dropped += (node->flags & UAW_TX_NODE_F_LAST) ? 1 : 0;
+                uaw_tx_node_free(ctx, node);
+                continue;
             }
+            ctx->tx_pending = node;
+            ctx->stats.tx_transfers++;
+        }
+#endif
+#if CONFIG_UART_INTERRUPT_DRIVEN
+        if (ctx->backend == UAW_BACKEND_IRQ) {
+            ctx->tx_pending = node;
+            ctx->tx_progress = 0;
+            ctx->stats.tx_transfers++;
+            uart_irq_tx_enable(ctx->uart); /* kick off ISR to start filling */
         }
+#endif
+    }
+    return dropped;
+}
+
+/* Release the transfer in flight and start the next one. Returns the number
+ * of writes completed by it, i.e. the UAW_TX_NODE_F_LAST nodes it carried,
+ * plus any writes dropped while starting the next one.
+ */
+static size_t uaw_tx_retire(struct uart_ctx* ctx)
+{
+    size_t done = 0;
+    bool retired = false;
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+
+    if (ctx->tx_pending) {
+#if CONFIG_UART_WRAPPER_STATS
+        ctx->stats.bytes_out += ctx->tx_pending->len;
+        uaw_stat_latency(ctx, ctx->tx_pending->t_enq);
+#endif
+        uaw_tx_bytes_done(ctx, ctx->tx_pending->len);
+        done = (ctx->tx_pending->flags & UAW_TX_NODE_F_LAST) ? 1 : 0;
+        uaw_tx_node_free(ctx, ctx->tx_pending);
+        ctx->tx_pending = NULL;
+        ctx->tx_progress = 0;
+        retired = true;
+    }
+    else if (ctx->tx_stage_nodes) {
+#if CONFIG_UART_WRAPPER_STATS
+        ctx->stats.bytes_out += ctx->tx_stage_len;
+        uaw_stat_latency(ctx, ctx->tx_stage_t_enq);
+#endif
+        uaw_tx_bytes_done(ctx, ctx->tx_stage_len);
+        done = ctx->tx_stage_writes;
+        ctx->tx_stage_nodes = 0;
+        ctx->tx_stage_writes = 0;
+        ctx->tx_stage_len = 0;
+        retired = true;
+    }
+    done += uaw_tx_start_next(ctx);
+
+    uaw_tx_unlock(ctx, key);
+
+#if CONFIG_UART_WRAPPER_MANAGER
+    if (retired && ctx->mgr_port) {
+        /* Queue space freed on a managed port, even mid-write */
+        uaw_mgr_port_tx_space(ctx->mgr_port);
+    }
+#else
+    ARG_UNUSED(retired);
+#endif
+    return done;
+}
+
+/* Report @p writes completed writes to tx_done_cb. Called without ctx->lock. */
+static void uaw_tx_done_report(struct uart_ctx* ctx, size_t writes)
+{
+    for (; writes > 0; writes--) {
         if (ctx->tx_done_cb) {
             ctx->tx_done_cb(ctx, ctx->user_data);
         }
+    }
+}
+
+/* Pool index of the RX buffer containing @p data, -1 if none. */
+static int uaw_rx_buf_index(const struct uart_ctx* ctx, const uint8_t* data)
+{
+    for (size_t i = 0; i < ctx->rx_buf_count; i++) {
+        if (data >= ctx->rx_buf[i] && data < ctx->rx_buf[i] + ctx->rx_buf_len) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/* Hand out the next buffer owned by neither the driver nor the consumer,
+ * round-robin from the last one. Returns its index, -1 if all are in use.
+ * Caller holds ctx->lock.
+ */
+static int uaw_rx_buf_take(struct uart_ctx* ctx)
+{
+    for (size_t n = 0; n < ctx->rx_buf_count; n++) {
+        size_t idx = (ctx->rx_buf_next + n) % ctx->rx_buf_count;
+
+        if (!(ctx->rx_buf_busy & BIT(idx)) && ctx->rx_buf_holds[idx] == 0) {
+            ctx->rx_buf_busy |= BIT(idx);
+            ctx->rx_buf_next = (idx + 1) % ctx->rx_buf_count;
+            return (int)idx;
+        }
+    }
+    return -1;
+}
+
+#if CONFIG_UART_ASYNC_API
+/* Start reception into buffer @p idx, already taken with uaw_rx_buf_take(). */
+static int uaw_rx_restart(struct uart_ctx* ctx, int idx)
+{
+    int rc = uart_rx_enable(ctx->uart, ctx->rx_buf[idx], ctx->rx_buf_len, ctx->rx_timeout_us);
+
+    if (rc && rc != -EALREADY) {
+        LOG_ERR("uart_rx_enable failed rc=%d", rc);
+        k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+        ctx->rx_buf_busy &= ~BIT(idx);
+        ctx->rx_enabled = false;
+        k_spin_unlock(&ctx->lock, key);
+    }
+    return rc;
+}
+#endif
+
+#if CONFIG_UART_ASYNC_API
+static void uaw_uart_cb(const struct device* dev, struct uart_event* evt, void* user_data)
+{
+    struct uart_ctx* ctx = (struct uart_ctx*)user_data;
+    int rc;
+
+    if (evt->type <= UART_RX_STOPPED) {
+        uaw_stat_isr(ctx, (enum uaw_isr_evt)evt->type);
+    }
+
+    switch (evt->type) {
+    case UART_TX_DONE:
+    case UART_TX_ABORTED:
+        uaw_tx_done_report(ctx, uaw_tx_retire(ctx));
         break;
 
-    case UART_RX_BUF_REQUEST:
-        rc = uart_rx_buf_rsp(dev, ctx->rx_buf[ctx->rx_idx], ctx->rx_buf_len);
-        __ASSERT_NO_MSG(rc == 0);
-        ctx->rx_idx ^= 1U;
+    case UART_RX_BUF_REQUEST: {
+        k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+        int idx = uaw_rx_buf_take(ctx);
+
+        if (idx < 0) {
+            /* Leave the request unanswered, the driver stops RX when the current buffer fills */
+            ctx->stats.rx_buf_starved++;
+        }
+        k_spin_unlock(&ctx->lock, key);
+
+        if (idx >= 0) {
+            rc = uart_rx_buf_rsp(dev, ctx->rx_buf[idx], ctx->rx_buf_len);
+            __ASSERT_NO_MSG(rc == 0);
+        }
+        break;
+    }
+
+    case UART_RX_BUF_RELEASED: {
+        k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+        int idx = uaw_rx_buf_index(ctx, evt->data.rx_buf.buf);
+
+        if (idx >= 0) {
+            ctx->rx_buf_busy &= ~BIT(idx);
+        }
+        k_spin_unlock(&ctx->lock, key);
+        break;
+    }
+
+    case UART_RX_DISABLED: {
+        /* RX stays on until uaw_rx_disable(): restart after a starved or failed reception */
+        k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+        int idx = -1;
+
+        ctx->rx_buf_busy = 0;
+        if (ctx->rx_enabled) {
+            idx = uaw_rx_buf_take(ctx);
+            /* Every buffer is held by the consumer, the next uaw_rx_buf_release() restarts RX */
+            ctx->rx_starved = idx < 0;
+        }
+        k_spin_unlock(&ctx->lock, key);
+
+        if (idx >= 0) {
+            uaw_rx_restart(ctx, idx);
+        }
         break;
+    }
 
     case UART_RX_RDY:
         if (evt->data.rx.len) {
-            const uint8_t* ptr = evt->data.rx.buf + evt->data.rx.offset;
-            if (ctx->rx_ring.size) {
-                ring_buf_put(&ctx->rx_ring, ptr, evt->data.rx.len);
-            }
+            uint8_t* ptr = evt->data.rx.buf + evt->data.rx.offset;
+            uaw_rx_push(ctx, ptr, evt->data.rx.len);
+            uaw_stat_rx(ctx, evt->data.rx.len);
             if (ctx->rx_cb) {
                 ctx->rx_cb(ctx, ptr, evt->data.rx.len, ctx->user_data);
             }
+#if CONFIG_UART_WRAPPER_FRAMING
+            if (ctx->framer) {
+                /* RX_RDY before the end of the buffer means the RX timeout hit, i.e. the line went idle */
+                bool idle = evt->data.rx.offset + evt->data.rx.len < ctx->rx_buf_len;
+                uaw_framer_feed(ctx, ctx->framer, ptr, evt->data.rx.len, idle);
+            }
+#endif
         }
         break;
 
@@ -86,29 +539,62 @@ static void uaw_irq_handler(const struct device* dev, void* user_data)
     if (uart_irq_update(dev) && uart_irq_is_pending(dev)) {
         /* RX ready */
         if (uart_irq_rx_ready(dev)) {
-            uint8_t buf[32];
-            int len = uart_fifo_read(dev, buf, sizeof(buf));
+            uaw_stat_isr(ctx, UAW_ISR_IRQ_RX);
+            /* Read straight into the RX ring, unless a framer needs a private
+             * copy to decode in place or the ring is full or not configured.
+             */
+            uint8_t scratch[32];
+            uint8_t* buf = NULL;
+            uint32_t room = 0;
+            if (ctx->rx_ring.size && !UAW_FRAMER(ctx)) {
+                room = ring_buf_put_claim(&ctx->rx_ring, &buf, sizeof(scratch));
+            }
+            if (room == 0) {
+                buf = scratch;
+                room = sizeof(scratch);
+            }
+            int len = uart_fifo_read(dev, buf, room);
+            if (buf != scratch) {
+                ring_buf_put_finish(&ctx->rx_ring, MAX(len, 0));
+            }
+            else if (len > 0) {
+                uaw_rx_push(ctx, buf, len);
+            }
             if (len > 0) {
-                ring_buf_put(&ctx->rx_ring, buf, len);
-                if (ctx->rx_cb) {
-                    ctx->rx_cb(ctx, buf, len, ctx->user_data);
-                }
+                uaw_stat_rx(ctx, len);
+            }
+            if (len > 0 && ctx->rx_cb) {
+                ctx->rx_cb(ctx, buf, len, ctx->user_data);
             }
+#if CONFIG_UART_WRAPPER_FRAMING
+            if (len > 0 && ctx->framer) {
+                uaw_framer_feed(ctx, ctx->framer, buf, len, false);
+            }
+#endif
         }
 
         /* TX ready */
         if (uart_irq_tx_ready(dev)) {
+            uaw_stat_isr(ctx, UAW_ISR_IRQ_TX);
             if (ctx->tx_pending) {
                 /* Keep filling until fifo can't accept more or buffer finished */
                 while (ctx->tx_pending && uart_irq_tx_ready(dev)) {
                     size_t remaining = ctx->tx_pending->len - ctx->tx_progress;
                     if (remaining == 0) {
-                        break;
+                        if (k_fifo_is_empty(&ctx->tx_fifo)) {
+                            break;
+                        }
+                        /* Chain the next node into the FIFO instead of waiting for TX complete */
+                        size_t done = uaw_tx_retire(ctx);
+
+                        ctx->stats.tx_irqs_saved++;
+                        uaw_tx_done_report(ctx, done);
+                        continue;
                     }
                     int can_write = uart_irq_tx_ready(dev);
                     /* can_write returns >0: minimum bytes that may be written */
                     int to_write = (int)MIN(remaining, (size_t)can_write);
-                    int written = uart_fifo_fill(dev, ctx->tx_pending->data + ctx->tx_progress, to_write);
+                    int written = uart_fifo_fill(dev, ctx->tx_pending->buf + ctx->tx_progress, to_write);
                     if (written <= 0) {
                         /* hardware doesn't accept any now */
                         break;
@@ -127,22 +613,9 @@ static void uaw_irq_handler(const struct device* dev, void* user_data)
 
         /* TX complete */
         if (uart_irq_tx_complete(dev)) {
-            if (ctx->tx_pending) {
-                k_free(ctx->tx_pending);
-                ctx->tx_pending = NULL;
-                ctx->tx_progress = 0;
-                if (ctx->tx_done_cb) {
-                    ctx->tx_done_cb(ctx, ctx->user_data);
-                }
-            }
-            /* Start next queued */
-            struct tx_node* node = k_fifo_get(&ctx->tx_fifo, K_NO_WAIT);
-            if (node) {
-                ctx->tx_pending = node;
-                ctx->tx_progress = 0;
-                uart_irq_tx_enable(dev);
-            }
-            else {
+            uaw_stat_isr(ctx, UAW_ISR_IRQ_TX_COMPLETE);
+            uaw_tx_done_report(ctx, uaw_tx_retire(ctx));
+            if (!ctx->tx_pending) {
                 /* no more data: disable TX interrupts */
                 uart_irq_tx_disable(dev);
             }
@@ -153,18 +626,41 @@ static void uaw_irq_handler(const struct device* dev, void* user_data)
 
 int uaw_init(struct uart_ctx* ctx, const struct device* uart_dev, uint8_t* rx_a, uint8_t* rx_b, size_t rx_buf_len, uint32_t rx_timeout_us,
              uaw_rx_cb_t rx_cb, uaw_tx_done_cb_t tx_done_cb, void* user_data)
+{
+    uint8_t* const rx_bufs[] = {rx_a, rx_b};
+
+    return uaw_init_bufs(ctx, uart_dev, rx_bufs, ARRAY_SIZE(rx_bufs), rx_buf_len, rx_timeout_us, rx_cb, tx_done_cb, user_data);
+}
+
+int uaw_init_bufs(struct uart_ctx* ctx, const struct device* uart_dev, uint8_t* const rx_bufs[], size_t rx_buf_count, size_t rx_buf_len,
+                  uint32_t rx_timeout_us, uaw_rx_cb_t rx_cb, uaw_tx_done_cb_t tx_done_cb, void* user_data)
 {
     __ASSERT(ctx != NULL, "ctx required");
     __ASSERT(uart_dev != NULL, "uart_dev required");
-    __ASSERT(rx_a != NULL && rx_b != NULL, "rx buffers required");
+    __ASSERT(rx_buf_count >= 2 && rx_buf_count <= CONFIG_UART_WRAPPER_RX_BUF_COUNT, "rx_buf_count out of range");
     __ASSERT(rx_buf_len > 0, "rx_buf_len must be > 0");
 
+    if (!ctx || !uart_dev || !rx_bufs || rx_buf_count < 2 || rx_buf_count > CONFIG_UART_WRAPPER_RX_BUF_COUNT || rx_buf_len == 0) {
+        return -EINVAL;
+    }
+    for (size_t i = 0; i < rx_buf_count; i++) {
+        if (!rx_bufs[i]) {
+            return -EINVAL;
+        }
+    }
+
+#if CONFIG_UART_WRAPPER_SHELL
+    /* Unlink first: the memset below would cut the list after a context initialized twice */
+    uaw_shell_unregister(ctx);
+#endif
     memset(ctx, 0, sizeof(*ctx));
     ctx->uart = uart_dev;
-    ctx->rx_buf[0] = rx_a;
-    ctx->rx_buf[1] = rx_b;
+    k_sem_init(&ctx->tx_space_sem, 0, 1);
+    for (size_t i = 0; i < rx_buf_count; i++) {
+        ctx->rx_buf[i] = rx_bufs[i];
+    }
+    ctx->rx_buf_count = rx_buf_count;
     ctx->rx_buf_len = rx_buf_len;
-    ctx->rx_idx = 1U;
     ctx->rx_timeout_us = rx_timeout_us;
     ctx->rx_cb = rx_cb;
     ctx->tx_done_cb = tx_done_cb;
@@ -176,6 +672,10 @@ int uaw_init(struct uart_ctx* ctx, const struct device* uart_dev, uint8_t* rx_a,
         return -ENODEV;
     }
 
+#if CONFIG_UART_WRAPPER_SHELL
+    uaw_shell_register(ctx);
+#endif
+
 #if CONFIG_UART_ASYNC_API
     LOG_INF("Adding callback for ASYNC API");
     if (test_async_api(uart_dev)) {
@@ -210,15 +710,38 @@ int uaw_init(struct uart_ctx* ctx, const struct device* uart_dev, uint8_t* rx_a,
 
 int uaw_rx_enable(struct uart_ctx* ctx)
 {
-    int rc = uart_rx_enable(ctx->uart, ctx->rx_buf[0], ctx->rx_buf_len, ctx->rx_timeout_us);
-    if (rc && rc != -EALREADY) {
-        LOG_ERR("uart_rx_enable failed rc=%d", rc);
+#if CONFIG_UART_ASYNC_API
+    if (ctx->backend != UAW_BACKEND_ASYNC) {
+        return -ENOTSUP;
     }
-    return rc;
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+    int idx = uaw_rx_buf_take(ctx);
+
+    if (idx >= 0) {
+        ctx->rx_enabled = true;
+        ctx->rx_starved = false;
+    }
+    k_spin_unlock(&ctx->lock, key);
+
+    if (idx < 0) {
+        /* The driver still owns a buffer, i.e. RX is running */
+        return ctx->rx_enabled ? -EALREADY : -ENOMEM;
+    }
+    return uaw_rx_restart(ctx, idx);
+#else
+    ARG_UNUSED(ctx);
+    return -ENOTSUP;
+#endif
 }
 
 int uaw_rx_disable(struct uart_ctx* ctx)
 {
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+    ctx->rx_enabled = false;
+    ctx->rx_starved = false;
+    k_spin_unlock(&ctx->lock, key);
+
     int rc = uart_rx_disable(ctx->uart);
     if (rc && rc != -EALREADY) {
         LOG_ERR("uart_rx_disable rc=%d", rc);
@@ -230,11 +753,67 @@ int uaw_rx_deinit(struct uart_ctx* ctx)
 {
     if (!ctx)
         return -EINVAL;
-    (void)uart_rx_disable(ctx->uart);
+    (void)uaw_rx_disable(ctx);
     ring_buf_reset(&ctx->rx_ring);
     return 0;
 }
 
+int uaw_rx_buf_hold(struct uart_ctx* ctx, const uint8_t* data)
+{
+    if (!ctx || !data) {
+        return -EINVAL;
+    }
+
+    int rc = 0;
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+    int idx = uaw_rx_buf_index(ctx, data);
+
+    if (idx < 0) {
+        rc = -EINVAL;
+    }
+    else if (ctx->rx_buf_holds[idx] == UINT8_MAX) {
+        rc = -EOVERFLOW;
+    }
+    else {
+        ctx->rx_buf_holds[idx]++;
+    }
+    k_spin_unlock(&ctx->lock, key);
+
+    return rc;
+}
+
+int uaw_rx_buf_release(struct uart_ctx* ctx, const uint8_t* data)
+{
+    if (!ctx || !data) {
+        return -EINVAL;
+    }
+
+    int idx = -1;
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+    int held = uaw_rx_buf_index(ctx, data);
+
+    if (held < 0 || ctx->rx_buf_holds[held] == 0) {
+        k_spin_unlock(&ctx->lock, key);
+        return -EINVAL;
+    }
+    ctx->rx_buf_holds[held]--;
+    if (ctx->rx_starved && ctx->rx_enabled) {
+        idx = uaw_rx_buf_take(ctx);
+        ctx->rx_starved = idx < 0;
+    }
+    k_spin_unlock(&ctx->lock, key);
+
+#if CONFIG_UART_ASYNC_API
+    if (idx >= 0) {
+        /* RX stopped for lack of buffers, this one gets it going again */
+        (void)uaw_rx_restart(ctx, idx);
+    }
+#else
+    ARG_UNUSED(idx);
+#endif
+    return 0;
+}
+
 int uaw_rx_ring_init(struct uart_ctx* ctx, uint8_t* ring_storage, size_t ring_size)
 {
     if (!ctx || !ring_storage || !ring_size) {
@@ -252,74 +831,279 @@ size_t uaw_rx_get(struct uart_ctx* ctx, uint8_t* dst, size_t len)
     return ring_buf_get(&ctx->rx_ring, dst, len);
 }
 
+size_t uaw_rx_claim(struct uart_ctx* ctx, uint8_t** data, size_t max)
+{
+    if (!ctx || !data || !max || !ctx->rx_ring.size) {
+        return 0;
+    }
+    return ring_buf_get_claim(&ctx->rx_ring, data, max);
+}
+
+int uaw_rx_finish(struct uart_ctx* ctx, size_t len)
+{
+    if (!ctx) {
+        return -EINVAL;
+    }
+    return ring_buf_get_finish(&ctx->rx_ring, len);
+}
+
 bool uaw_tx_busy(struct uart_ctx* ctx)
 {
-    return ctx->tx_pending != NULL;
+    return ctx->tx_pending != NULL || ctx->tx_stage_nodes != 0;
+}
+
+size_t uaw_tx_queued_bytes(struct uart_ctx* ctx)
+{
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+    size_t bytes = ctx->tx_queued_bytes;
+    k_spin_unlock(&ctx->lock, key);
+
+    return bytes;
+}
+
+int uaw_get_stats(struct uart_ctx* ctx, struct uaw_stats* stats)
+{
+    if (!ctx || !stats) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+    *stats = ctx->stats;
+    k_spin_unlock(&ctx->lock, key);
+
+    return 0;
+}
+
+int uaw_reset_stats(struct uart_ctx* ctx)
+{
+    if (!ctx) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+    k_spin_unlock(&ctx->lock, key);
+
+    return 0;
+}
+
+int uaw_tx_pool_set(struct uart_ctx* ctx, struct k_mem_slab* slab)
+{
+    if (!ctx) {
+        return -EINVAL;
+    }
+    if (slab && slab->info.block_size <= sizeof(struct tx_node)) {
+        return -EINVAL;
+    }
+    if (uaw_tx_busy(ctx) || !k_fifo_is_empty(&ctx->tx_fifo)) {
+        return -EBUSY;
+    }
+
+    ctx->tx_slab = slab;
+    ctx->tx_node_payload = slab ? slab->info.block_size - sizeof(struct tx_node) : 0;
+    return 0;
 }
 
 int uaw_tx_cancel_and_flush(struct uart_ctx* ctx)
 {
+    struct tx_node* n;
+    size_t flushed = 0;
+
+    /* Empty the queue before aborting: the UART_TX_ABORTED event retires the
+     * transfer in flight and would otherwise start the next queued node.
+     */
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+    while ((n = k_fifo_get(&ctx->tx_fifo, K_NO_WAIT)) != NULL) {
+        flushed += n->len;
+        uaw_tx_node_free(ctx, n);
+    }
+    uaw_tx_bytes_done(ctx, flushed);
+    uaw_tx_unlock(ctx, key);
+
     int rc = uart_tx_abort(ctx->uart);
     if (rc && rc != -EFAULT && rc != -ENOTSUP) {
         LOG_WRN("uart_tx_abort rc=%d", rc);
     }
-    struct tx_node* n;
-    while ((n = k_fifo_get(&ctx->tx_fifo, K_NO_WAIT)) != NULL) {
-        k_free(n);
+    return 0;
+}
+
+int uaw_tx_watermark_set(struct uart_ctx* ctx, size_t high, size_t low, uaw_tx_wm_cb_t cb)
+{
+    if (!ctx || (high && low >= high)) {
+        return -EINVAL;
     }
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+    ctx->tx_high_wm = high;
+    ctx->tx_low_wm = high ? low : 0;
+    ctx->tx_wm_cb = cb;
+    ctx->tx_above_wm = false;
+    if (ctx->tx_waiters) {
+        ctx->tx_wm_actions |= UAW_WM_ACT_WAKE;
+    }
+    uaw_tx_unlock(ctx, key);
+
     return 0;
 }
 
+/* Count @p bytes into the TX queue. Caller holds ctx->lock. */
+static void uaw_tx_bytes_add(struct uart_ctx* ctx, size_t bytes)
+{
+    ctx->tx_queued_bytes += bytes;
+#if CONFIG_UART_WRAPPER_STATS
+    ctx->stats.tx_queue_hwm = MAX(ctx->stats.tx_queue_hwm, ctx->tx_queued_bytes);
+#endif
+}
+
+/* Admit @p bytes into the TX queue, waiting up to @p timeout while the queue
+ * is above the high watermark.
+ */
+static int uaw_tx_reserve(struct uart_ctx* ctx, size_t bytes, k_timeout_t timeout)
+{
+    k_timepoint_t end = sys_timepoint_calc(timeout);
+
+    for (;;) {
+        k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+
+        if (!ctx->tx_high_wm || ctx->tx_queued_bytes == 0
+            || (!ctx->tx_above_wm && ctx->tx_queued_bytes + bytes <= ctx->tx_high_wm)) {
+            uaw_tx_bytes_add(ctx, bytes);
+            uaw_tx_unlock(ctx, key);
+            return 0;
+        }
+
+        if (!ctx->tx_above_wm) {
+            ctx->tx_above_wm = true;
+            ctx->tx_wm_actions |= UAW_WM_ACT_HIGH;
+        }
+        if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+            uaw_tx_unlock(ctx, key);
+            return -EAGAIN;
+        }
+        ctx->tx_waiters++;
+        uaw_tx_unlock(ctx, key);
+
+        int rc = k_sem_take(&ctx->tx_space_sem, sys_timepoint_timeout(end));
+
+        key = k_spin_lock(&ctx->lock);
+        ctx->tx_waiters--;
+        k_spin_unlock(&ctx->lock, key);
+
+        if (rc) {
+            return -EAGAIN;
+        }
+    }
+}
+
+/* Queue an already accounted chain and start TX if idle. */
+static void uaw_tx_chain_queue(struct uart_ctx* ctx, struct uaw_tx_chain* chain)
+{
+#if CONFIG_UART_WRAPPER_STATS
+    uint32_t now = k_cycle_get_32();
+    for (struct tx_node* n = chain->head; n; n = n->fifo_reserved) {
+        n->t_enq = now;
+    }
+#endif
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+    k_fifo_put_list(&ctx->tx_fifo, chain->head, chain->tail);
+    size_t dropped = uaw_tx_start_next(ctx);
+    uaw_tx_unlock(ctx, key);
+
+    chain->head = NULL;
+    chain->tail = NULL;
+    uaw_tx_done_report(ctx, dropped);
+}
+
+/* Queue @p iov as one unit: either every node is queued in order or none is. */
+static int uaw_tx_submit(struct uart_ctx* ctx, const struct uaw_iovec* iov, size_t iovcnt, size_t zc_min, k_timeout_t timeout)
+{
+    struct uaw_tx_chain chain = {0};
+    size_t total = 0;
+    k_spinlock_key_t key;
+
+    if (ctx->backend != UAW_BACKEND_ASYNC && ctx->backend != UAW_BACKEND_IRQ) {
+        return -ENOTSUP;
+    }
+
+    for (size_t i = 0; i < iovcnt; i++) {
+        total += iov[i].len;
+    }
+    if (total == 0) {
+        return -EINVAL;
+    }
+
+    int rc = uaw_tx_reserve(ctx, total, timeout);
+    if (rc) {
+        return rc;
+    }
+
+    rc = uaw_tx_chain_build(ctx, iov, iovcnt, zc_min, &chain);
+    if (rc) {
+        uaw_tx_chain_free(ctx, &chain);
+        key = k_spin_lock(&ctx->lock);
+        uaw_tx_bytes_done(ctx, total);
+        uaw_tx_unlock(ctx, key);
+        return rc;
+    }
+
+    uaw_tx_chain_queue(ctx, &chain);
+    return 0;
+}
+
+void uaw_tx_chain_submit(struct uart_ctx* ctx, struct uaw_tx_chain* chain)
+{
+    size_t total = 0;
+
+    if (!chain->head) {
+        return;
+    }
+
+    for (struct tx_node* n = chain->head; n; n = n->fifo_reserved) {
+        total += n->len;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&ctx->lock);
+    uaw_tx_bytes_add(ctx, total);
+    k_spin_unlock(&ctx->lock, key);
+
+    uaw_tx_chain_queue(ctx, chain);
+}
+
 int uaw_write(struct uart_ctx* ctx, const void* data, size_t len)
+{
+    return uaw_write_timeout(ctx, data, len, K_NO_WAIT);
+}
+
+int uaw_write_timeout(struct uart_ctx* ctx, const void* data, size_t len, k_timeout_t timeout)
 {
     if (!data || len == 0) {
         return -EINVAL;
     }
 
-    struct tx_node* node = k_malloc(sizeof(struct tx_node) + len);
-    if (!node) {
-        return -ENOMEM;
-    }
-    node->len = len;
-    memcpy(node->data, data, len);
-
-    if (ctx->backend == UAW_BACKEND_ASYNC) {
-        /* async path (your existing code) */
-        unsigned int key = irq_lock();
-        int start_immediately = (ctx->tx_pending == NULL);
-        irq_unlock(key);
-
-        if (start_immediately) {
-            int rc = uart_tx(ctx->uart, node->data, node->len, SYS_FOREVER_US);
-            if (rc == 0) {
-                ctx->tx_pending = node;
-                return 0;
-            }
-            if (rc != -EBUSY) {
-                k_free(node);
-                return rc;
-            }
-        }
-        k_fifo_put(&ctx->tx_fifo, node);
-        return 0;
+    const struct uaw_iovec iov = {.base = data, .len = len};
+
+    return uaw_tx_submit(ctx, &iov, 1, SIZE_MAX, timeout);
+}
+
+int uaw_writev(struct uart_ctx* ctx, const struct uaw_iovec* iov, size_t iovcnt)
+{
+    if (!iov || iovcnt == 0) {
+        return -EINVAL;
     }
 
-    if (ctx->backend == UAW_BACKEND_IRQ) {
-        unsigned int key = irq_lock();
-        if (!ctx->tx_pending) {
-            ctx->tx_pending = node;
-            ctx->tx_progress = 0;
-            uart_irq_tx_enable(ctx->uart); /* kick off ISR to start filling */
-            irq_unlock(key);
-            return 0;
-        }
-        irq_unlock(key);
-        k_fifo_put(&ctx->tx_fifo, node);
-        return 0;
+    return uaw_tx_submit(ctx, iov, iovcnt, CONFIG_UART_WRAPPER_ZERO_COPY_THRESHOLD, K_NO_WAIT);
+}
+
+int uaw_write_borrowed(struct uart_ctx* ctx, const void* data, size_t len)
+{
+    if (!data || len == 0) {
+        return -EINVAL;
     }
 
-    k_free(node);
-    return -ENOTSUP;
+    const struct uaw_iovec iov = {.base = data, .len = len};
+
+    return uaw_tx_submit(ctx, &iov, 1, 0, K_NO_WAIT);
 }
 
 int uaw_deinit(struct uart_ctx* ctx)
@@ -329,5 +1113,8 @@ int uaw_deinit(struct uart_ctx* ctx)
     uaw_tx_cancel_and_flush(ctx);
     uaw_rx_deinit(ctx);
     (void)uart_callback_set(ctx->uart, NULL, NULL);
+#if CONFIG_UART_WRAPPER_SHELL
+    uaw_shell_unregister(ctx);
+#endif
     return 0;
 }
@@ -15,6 +15,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/slist.h>
 #include <zephyr/sys/util.h>
 
 #ifdef __cplusplus
@@ -27,11 +28,15 @@ extern "C" {
  * Holds state and configuration for UART operations.
  */
 struct uart_ctx;
+struct uaw_framer;
+struct uaw_mgr_port;
 
 /**
  * @brief RX callback type for UART wrapper.
  *
- * Called when data is received.
+ * Called when data is received. With the async backend @p data points into
+ * an RX DMA buffer, which may be refilled once the callback returns unless
+ * it is held with uaw_rx_buf_hold().
  *
  * @param ctx UART context pointer.
  * @param data Pointer to received data.
@@ -43,13 +48,31 @@ typedef void (*uaw_rx_cb_t)(struct uart_ctx* ctx, const uint8_t* data, size_t le
 /**
  * @brief TX done callback type for UART wrapper.
  *
- * Called when transmission is complete.
+ * Called once per completed write, in write order, after the last byte of
+ * the write has left the wrapper. Writes split across several TX nodes
+ * (pooled nodes, uaw_writev() segments) still complete only once. A write
+ * the driver refuses to send is dropped and still completes, so memory lent
+ * with uaw_write_borrowed() or uaw_writev() can always be reused afterwards.
  *
  * @param ctx UART context pointer.
  * @param user_data User-provided context.
  */
 typedef void (*uaw_tx_done_cb_t)(struct uart_ctx* ctx, void* user_data);
 
+/**
+ * @brief TX watermark callback type for UART wrapper.
+ *
+ * Called with @p above_high true when a write finds the TX queue at the high
+ * watermark, and with false once it has drained to the low watermark. May be
+ * called from ISR context.
+ *
+ * @param ctx UART context pointer.
+ * @param above_high True when crossing the high watermark, false when
+ *                   dropping to the low watermark.
+ * @param user_data User-provided context.
+ */
+typedef void (*uaw_tx_wm_cb_t)(struct uart_ctx* ctx, bool above_high, void* user_data);
+
 /**
  * @brief UART backend type.
  */
@@ -59,20 +82,113 @@ enum uaw_backend {
     UAW_BACKEND_IRQ    /**< IRQ-driven backend */
 };
 
+/**
+ * @brief TX node flag: node was taken from the context TX pool.
+ */
+#define UAW_TX_NODE_F_POOL BIT(0)
+
+/**
+ * @brief TX node flag: @c buf points to caller memory, not to @c data.
+ */
+#define UAW_TX_NODE_F_BORROWED BIT(1)
+
+/**
+ * @brief TX node flag: last node of a write, its completion is the one
+ * reported to tx_done_cb.
+ */
+#define UAW_TX_NODE_F_LAST BIT(2)
+
 /**
  * @brief TX node structure for FIFO queue.
  *
  * @param fifo_reserved Reserved for FIFO internal use.
+ * @param buf Bytes to send, either @c data or borrowed caller memory.
  * @param len Length of data.
+ * @param flags Node flags (UAW_TX_NODE_F_*).
  * @param data Flexible array member for data.
  */
 struct tx_node
 {
     void* fifo_reserved;
+    const uint8_t* buf;
     size_t len;
+#if CONFIG_UART_WRAPPER_STATS
+    uint32_t t_enq; /**< k_cycle_get_32() when the node was queued */
+#endif
+    uint8_t flags;
     uint8_t data[];
 };
 
+/**
+ * @brief Scatter-gather segment for uaw_writev().
+ */
+struct uaw_iovec
+{
+    const void* base; /**< Segment start */
+    size_t len;       /**< Segment length */
+};
+
+/**
+ * @brief Size of one TX pool block able to carry @p payload bytes.
+ *
+ * @param payload Payload bytes per node.
+ */
+#define UAW_TX_NODE_SIZE(payload) ROUND_UP(sizeof(struct tx_node) + (payload), sizeof(void*))
+
+/**
+ * @brief Define a TX node pool to be handed to uaw_tx_pool_set().
+ *
+ * Each block carries up to CONFIG_UART_BUFFER_SIZE payload bytes. Writes
+ * larger than that are split across several blocks.
+ *
+ * @param name Name of the memory slab.
+ * @param count Number of TX nodes in the pool.
+ */
+#define UAW_TX_POOL_DEFINE(name, count) K_MEM_SLAB_DEFINE(name, UAW_TX_NODE_SIZE(CONFIG_UART_BUFFER_SIZE), count, sizeof(void*))
+
+/**
+ * @brief Interrupt events counted per context with CONFIG_UART_WRAPPER_STATS.
+ *
+ * The async entries share their values with enum uart_event_type.
+ */
+enum uaw_isr_evt {
+    UAW_ISR_TX_DONE,         /**< UART_TX_DONE */
+    UAW_ISR_TX_ABORTED,      /**< UART_TX_ABORTED */
+    UAW_ISR_RX_RDY,          /**< UART_RX_RDY */
+    UAW_ISR_RX_BUF_REQUEST,  /**< UART_RX_BUF_REQUEST */
+    UAW_ISR_RX_BUF_RELEASED, /**< UART_RX_BUF_RELEASED */
+    UAW_ISR_RX_DISABLED,     /**< UART_RX_DISABLED */
+    UAW_ISR_RX_STOPPED,      /**< UART_RX_STOPPED */
+    UAW_ISR_IRQ_RX,          /**< IRQ backend, RX ready */
+    UAW_ISR_IRQ_TX,          /**< IRQ backend, TX ready */
+    UAW_ISR_IRQ_TX_COMPLETE, /**< IRQ backend, TX complete */
+    UAW_ISR_EVT_COUNT,
+};
+
+/**
+ * @brief UART wrapper counters.
+ *
+ * The extended block is only present with CONFIG_UART_WRAPPER_STATS.
+ */
+struct uaw_stats
+{
+    uint32_t tx_transfers;       /**< Transfers handed to the driver */
+    uint32_t tx_coalesced_nodes; /**< TX nodes merged into a staged transfer */
+    uint32_t tx_irqs_saved;      /**< TX completion interrupts avoided by coalescing or chaining */
+    uint32_t rx_dropped;         /**< RX bytes lost because the RX ring was full */
+    uint32_t rx_buf_starved;     /**< RX buffer requests left unanswered because all buffers were in use */
+#if CONFIG_UART_WRAPPER_STATS
+    uint32_t bytes_in;     /**< Bytes received */
+    uint32_t bytes_out;    /**< Bytes transmitted */
+    uint32_t tx_queue_hwm; /**< High-water mark of bytes queued for TX */
+    uint32_t rx_ring_hwm;  /**< High-water mark of bytes held in the RX ring */
+    /** Enqueue to TX completion latency, one sample per transfer. Bucket i
+     *  counts latencies in [2^(i-1), 2^i) cycles, the last bucket everything above. */
+    uint32_t tx_latency_hist[CONFIG_UART_WRAPPER_STATS_LAT_BUCKETS];
+    uint32_t isr_events[UAW_ISR_EVT_COUNT]; /**< Interrupt entries per event type */
+#endif
+};
+
 /**
  * @brief UART context structure.
  *
@@ -83,22 +199,59 @@ struct uart_ctx
     const struct device* uart; /**< UART device pointer */
     enum uaw_backend backend;  /**< Backend type */
 
-    uint8_t* rx_buf[2];      /**< Double-buffer for RX */
-    size_t rx_buf_len;       /**< RX buffer length */
-    volatile uint8_t rx_idx; /**< Current RX buffer index */
-    uint32_t rx_timeout_us;  /**< RX timeout in microseconds */
+    uint8_t* rx_buf[CONFIG_UART_WRAPPER_RX_BUF_COUNT];      /**< RX DMA buffer pool */
+    size_t rx_buf_count;                                    /**< Number of buffers in the pool */
+    size_t rx_buf_len;                                      /**< RX buffer length */
+    uint32_t rx_buf_busy;                                   /**< Bitmask of buffers owned by the driver */
+    uint8_t rx_buf_holds[CONFIG_UART_WRAPPER_RX_BUF_COUNT]; /**< Consumer holds per buffer, see uaw_rx_buf_hold() */
+    size_t rx_buf_next;                                     /**< Next buffer to hand out, round-robin */
+    bool rx_enabled;                                        /**< Between uaw_rx_enable() and uaw_rx_disable() */
+    bool rx_starved;                                        /**< RX stopped with every buffer held */
+    uint32_t rx_timeout_us;                                 /**< RX timeout in microseconds */
+
+    struct ring_buf rx_ring; /**< RX ring buffer, filled from ISR, drained by one consumer thread */
+#if CONFIG_UART_WRAPPER_FRAMING
+    struct uaw_framer* framer; /**< Optional frame delimiting layer */
+#endif
+
+    struct k_fifo tx_fifo;       /**< TX FIFO queue */
+    struct tx_node* tx_pending;  /**< Pending TX node */
+    size_t tx_progress;          /**< TX progress (IRQ mode) */
+    struct k_mem_slab* tx_slab;  /**< Optional TX node pool, NULL uses the system heap */
+    size_t tx_node_payload;      /**< Payload bytes per pooled TX node */
+    size_t tx_stage_nodes;       /**< Nodes merged into the staged transfer in flight */
+    size_t tx_stage_writes;      /**< Writes completed by the staged transfer in flight */
+    size_t tx_stage_len;         /**< Bytes in the staged transfer in flight */
+#if CONFIG_UART_WRAPPER_STATS
+    uint32_t tx_stage_t_enq; /**< Enqueue time of the oldest node in the staged transfer */
+#endif
+#if CONFIG_UART_WRAPPER_TX_COALESCE_SIZE > 0
+    uint8_t tx_stage[CONFIG_UART_WRAPPER_TX_COALESCE_SIZE]; /**< TX coalescing staging buffer */
+#endif
 
-    struct ring_buf rx_ring; /**< RX ring buffer */
+    size_t tx_queued_bytes;       /**< Bytes accepted for TX and not yet completed */
+    size_t tx_high_wm;            /**< TX high watermark in bytes, 0 disables backpressure */
+    size_t tx_low_wm;             /**< TX low watermark in bytes */
+    bool tx_above_wm;             /**< High watermark reached, not yet drained to the low one */
+    uint8_t tx_wm_actions;        /**< Watermark actions deferred until the lock is released */
+    uint32_t tx_waiters;          /**< Writers blocked in uaw_write_timeout() */
+    struct k_sem tx_space_sem;    /**< Wakes blocked writers once below the watermark */
+    uaw_tx_wm_cb_t tx_wm_cb;      /**< TX watermark callback */
 
-    struct k_fifo tx_fifo;      /**< TX FIFO queue */
-    struct tx_node* tx_pending; /**< Pending TX node */
-    size_t tx_progress;         /**< TX progress (IRQ mode) */
+    struct uaw_stats stats; /**< Counters */
 
     uaw_rx_cb_t rx_cb;           /**< RX callback */
     uaw_tx_done_cb_t tx_done_cb; /**< TX done callback */
     void* user_data;             /**< User context */
 
     struct k_spinlock lock; /**< Spinlock for thread safety */
+
+#if CONFIG_UART_WRAPPER_SHELL
+    sys_snode_t shell_node; /**< Entry in the shell context registry */
+#endif
+#if CONFIG_UART_WRAPPER_MANAGER
+    struct uaw_mgr_port* mgr_port; /**< Manager port owning this context, if any */
+#endif
 };
 
 /**
@@ -118,11 +271,42 @@ struct uart_ctx
 int uaw_init(struct uart_ctx* ctx, const struct device* uart_dev, uint8_t* rx_a, uint8_t* rx_b, size_t rx_buf_len, uint32_t rx_timeout_us,
              uaw_rx_cb_t rx_cb, uaw_tx_done_cb_t tx_done_cb, void* user_data);
 
+/**
+ * @brief Initialize UART context with an N-deep RX buffer pool.
+ *
+ * The async backend hands the buffers to the driver round-robin, one per
+ * UART_RX_BUF_REQUEST, and takes them back on UART_RX_BUF_RELEASED. A
+ * buffer is not handed out again while the driver owns it or while the
+ * consumer holds it with uaw_rx_buf_hold(). The RX ring copies every chunk
+ * as it arrives, so extra buffers only matter for consumers that hold them.
+ *
+ * @param ctx UART context pointer.
+ * @param uart_dev UART device pointer.
+ * @param rx_bufs Array of RX buffers, each @p rx_buf_len bytes.
+ * @param rx_buf_count Number of RX buffers, 2..CONFIG_UART_WRAPPER_RX_BUF_COUNT.
+ * @param rx_buf_len RX buffer length.
+ * @param rx_timeout_us RX timeout in microseconds.
+ * @param rx_cb RX callback.
+ * @param tx_done_cb TX done callback.
+ * @param user_data User context.
+ * @return 0 on success, -EINVAL if a buffer is NULL or the count or length is
+ *         out of range, other negative error code on failure.
+ */
+int uaw_init_bufs(struct uart_ctx* ctx, const struct device* uart_dev, uint8_t* const rx_bufs[], size_t rx_buf_count, size_t rx_buf_len,
+                  uint32_t rx_timeout_us, uaw_rx_cb_t rx_cb, uaw_tx_done_cb_t tx_done_cb, void* user_data);
+
 /**
  * @brief Enable UART RX.
  *
+ * Reception stays on until uaw_rx_disable(). With the async backend, RX is
+ * restarted after the driver stops it, e.g. after a line error. If RX
+ * stopped because every buffer was held, the next uaw_rx_buf_release()
+ * restarts it.
+ *
  * @param ctx UART context pointer.
- * @return 0 on success, negative error code on failure.
+ * @return 0 on success, -EALREADY if RX is running, -ENOMEM if every buffer
+ *         is held, -ENOTSUP without the async backend, other negative error
+ *         code from the driver.
  */
 int uaw_rx_enable(struct uart_ctx* ctx);
 
@@ -162,16 +346,147 @@ int uaw_rx_ring_init(struct uart_ctx* ctx, uint8_t* ring_storage, size_t ring_si
  */
 size_t uaw_rx_get(struct uart_ctx* ctx, uint8_t* dst, size_t len);
 
+/**
+ * @brief Use a preallocated pool for TX nodes instead of the system heap.
+ *
+ * Once set, uaw_write() takes fixed-size nodes from @p slab in O(1) and never
+ * calls k_malloc(). Writes larger than one node payload are split across
+ * several nodes. Must be called before the first write.
+ *
+ * @param ctx UART context pointer.
+ * @param slab Memory slab, typically defined with UAW_TX_POOL_DEFINE().
+ *             NULL switches back to the system heap.
+ * @return 0 on success, -EINVAL if the slab blocks cannot hold a TX node,
+ *         -EBUSY if TX is in progress.
+ */
+int uaw_tx_pool_set(struct uart_ctx* ctx, struct k_mem_slab* slab);
+
+/**
+ * @brief Keep an RX DMA buffer from being reused.
+ *
+ * Call from the RX callback with the data pointer it was given to keep
+ * working on the data in place after the callback returns. The buffer
+ * holding @p data is not handed back to the driver until a matching
+ * uaw_rx_buf_release(). If every buffer is held when the driver asks for
+ * the next one, reception stops (counted in rx_buf_starved) and restarts on
+ * the next release. Async backend only.
+ *
+ * @param ctx UART context pointer.
+ * @param data Pointer into an RX buffer, as passed to the RX callback.
+ * @return 0 on success, -EINVAL if @p data is not in an RX buffer,
+ *         -EOVERFLOW if the buffer is held too often.
+ */
+int uaw_rx_buf_hold(struct uart_ctx* ctx, const uint8_t* data);
+
+/**
+ * @brief Return an RX buffer held with uaw_rx_buf_hold().
+ *
+ * @param ctx UART context pointer.
+ * @param data Any pointer into the held buffer.
+ * @return 0 on success, -EINVAL if @p data is not in a held RX buffer.
+ */
+int uaw_rx_buf_release(struct uart_ctx* ctx, const uint8_t* data);
+
+/**
+ * @brief Claim received data for in-place parsing.
+ *
+ * Returns a view into the RX ring without copying. The ring has a single
+ * producer (the UART ISR) and must have a single consumer, so no locking is
+ * needed. The view stays valid until uaw_rx_finish(). A wrap-around in the
+ * ring is returned as two consecutive claims.
+ *
+ * @param ctx UART context pointer.
+ * @param data Set to the start of the claimed bytes.
+ * @param max Maximum number of bytes to claim.
+ * @return Number of contiguous bytes claimed, 0 if the ring is empty.
+ */
+size_t uaw_rx_claim(struct uart_ctx* ctx, uint8_t** data, size_t max);
+
+/**
+ * @brief Release bytes obtained with uaw_rx_claim().
+ *
+ * @param ctx UART context pointer.
+ * @param len Number of bytes consumed, at most the claimed size.
+ * @return 0 on success, -EINVAL if @p len exceeds the claimed size.
+ */
+int uaw_rx_finish(struct uart_ctx* ctx, size_t len);
+
 /**
  * @brief Write data to UART.
  *
  * @param ctx UART context pointer.
  * @param data Data to send.
  * @param len Length of data.
- * @return 0 on success, negative error code on failure.
+ * @return 0 on success, -EAGAIN above the TX high watermark,
+ *         -ENOMEM if no TX node is available, negative error code on failure.
  */
 int uaw_write(struct uart_ctx* ctx, const void* data, size_t len);
 
+/**
+ * @brief Write data to UART, waiting for queue space if needed.
+ *
+ * With TX watermarks configured, a write that would push the queued bytes
+ * above the high watermark sleeps until the queue has drained to the low
+ * watermark or @p timeout expires. A write into an empty queue is always
+ * accepted.
+ *
+ * @param ctx UART context pointer.
+ * @param data Data to send.
+ * @param len Length of data.
+ * @param timeout Maximum time to wait for queue space.
+ * @return 0 on success, -EAGAIN if the queue stayed full until the timeout,
+ *         -ENOMEM if no TX node is available, negative error code on failure.
+ */
+int uaw_write_timeout(struct uart_ctx* ctx, const void* data, size_t len, k_timeout_t timeout);
+
+/**
+ * @brief Configure TX backpressure watermarks.
+ *
+ * Once the bytes queued for TX reach @p high, uaw_write(), uaw_writev() and
+ * uaw_write_borrowed() return -EAGAIN and uaw_write_timeout() blocks, until
+ * the queue has drained to @p low. @p cb is told about both transitions so
+ * producers can throttle.
+ *
+ * @param ctx UART context pointer.
+ * @param high High watermark in bytes, 0 disables backpressure.
+ * @param low Low watermark in bytes, must be below @p high.
+ * @param cb Watermark callback, may be NULL.
+ * @return 0 on success, -EINVAL on invalid arguments.
+ */
+int uaw_tx_watermark_set(struct uart_ctx* ctx, size_t high, size_t low, uaw_tx_wm_cb_t cb);
+
+/**
+ * @brief Write a frame assembled from several segments.
+ *
+ * Segments of at least CONFIG_UART_WRAPPER_ZERO_COPY_THRESHOLD bytes are
+ * sent straight from caller memory and must stay valid until the
+ * tx_done_cb for this write, which is called once after all segments.
+ * Runs of smaller segments are copied together into TX nodes. All segments
+ * are queued in order, or none are.
+ *
+ * @param ctx UART context pointer.
+ * @param iov Segment array.
+ * @param iovcnt Number of segments.
+ * @return 0 on success, -EAGAIN above the TX high watermark,
+ *         -ENOMEM if no TX node is available, negative error code on failure.
+ */
+int uaw_writev(struct uart_ctx* ctx, const struct uaw_iovec* iov, size_t iovcnt);
+
+/**
+ * @brief Write data without copying it.
+ *
+ * The UART transmits directly from @p data. The caller must keep the memory
+ * valid and unchanged until the tx_done_cb for this write. Completions are
+ * reported in write order.
+ *
+ * @param ctx UART context pointer.
+ * @param data Data to send.
+ * @param len Length of data.
+ * @return 0 on success, -EAGAIN above the TX high watermark,
+ *         -ENOMEM if no TX node is available, negative error code on failure.
+ */
+int uaw_write_borrowed(struct uart_ctx* ctx, const void* data, size_t len);
+
 /**
  * @brief Check if UART TX is busy.
  *
@@ -180,9 +495,37 @@ int uaw_write(struct uart_ctx* ctx, const void* data, size_t len);
  */
 bool uaw_tx_busy(struct uart_ctx* ctx);
 
+/**
+ * @brief Get the number of bytes accepted for TX and not yet completed.
+ *
+ * @param ctx UART context pointer.
+ * @return Queued bytes, including the transfer in flight.
+ */
+size_t uaw_tx_queued_bytes(struct uart_ctx* ctx);
+
+/**
+ * @brief Get a snapshot of the context counters.
+ *
+ * @param ctx UART context pointer.
+ * @param stats Destination for the counters.
+ * @return 0 on success, -EINVAL on invalid arguments.
+ */
+int uaw_get_stats(struct uart_ctx* ctx, struct uaw_stats* stats);
+
+/**
+ * @brief Clear the context counters.
+ *
+ * @param ctx UART context pointer.
+ * @return 0 on success, -EINVAL on invalid arguments.
+ */
+int uaw_reset_stats(struct uart_ctx* ctx);
+
 /**
  * @brief Cancel and flush UART TX.
  *
+ * Drops every queued write, then aborts the transfer in flight. No further
+ * queued node is started by the abort. Dropped writes get no tx_done_cb.
+ *
  * @param ctx UART context pointer.
  * @return 0 on success, negative error code on failure.
  */
@@ -196,6 +539,46 @@ int uaw_tx_cancel_and_flush(struct uart_ctx* ctx);
  */
 int uaw_deinit(struct uart_ctx* ctx);
 
+/**
+ * @internal
+ * @brief Singly linked list of TX nodes, linked through fifo_reserved.
+ */
+struct uaw_tx_chain
+{
+    struct tx_node* head;
+    struct tx_node* tail;
+};
+
+/**
+ * @internal
+ * @brief Build TX nodes for @p iov without queueing them.
+ *
+ * Segments of at least @p zc_min bytes are borrowed, the rest is copied.
+ * On failure the nodes built so far are left in @p chain.
+ */
+int uaw_tx_chain_build(struct uart_ctx* ctx, const struct uaw_iovec* iov, size_t iovcnt, size_t zc_min, struct uaw_tx_chain* chain);
+
+/**
+ * @internal
+ * @brief Queue a chain built by uaw_tx_chain_build(), bypassing watermarks.
+ */
+void uaw_tx_chain_submit(struct uart_ctx* ctx, struct uaw_tx_chain* chain);
+
+/**
+ * @internal
+ * @brief Release every node of a chain that was not submitted.
+ */
+void uaw_tx_chain_free(struct uart_ctx* ctx, struct uaw_tx_chain* chain);
+
+#if CONFIG_UART_WRAPPER_SHELL
+/**
+ * @internal
+ * @brief Add a context to, or remove it from, the shell registry.
+ */
+void uaw_shell_register(struct uart_ctx* ctx);
+void uaw_shell_unregister(struct uart_ctx* ctx);
+#endif
+
 /**
  * @brief Get UART device from context.
  *
@@ -0,0 +1,115 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/slist.h>
+
+#include "uart_wrapper.h"
+
+static sys_slist_t uaw_ctx_list = SYS_SLIST_STATIC_INIT(&uaw_ctx_list);
+static struct k_spinlock uaw_ctx_list_lock;
+
+void uaw_shell_register(struct uart_ctx* ctx)
+{
+    k_spinlock_key_t key = k_spin_lock(&uaw_ctx_list_lock);
+    (void)sys_slist_find_and_remove(&uaw_ctx_list, &ctx->shell_node);
+    sys_slist_append(&uaw_ctx_list, &ctx->shell_node);
+    k_spin_unlock(&uaw_ctx_list_lock, key);
+}
+
+void uaw_shell_unregister(struct uart_ctx* ctx)
+{
+    k_spinlock_key_t key = k_spin_lock(&uaw_ctx_list_lock);
+    (void)sys_slist_find_and_remove(&uaw_ctx_list, &ctx->shell_node);
+    k_spin_unlock(&uaw_ctx_list_lock, key);
+}
+
+/* Contexts are only unregistered by uaw_deinit(), which callers do not race with the shell. */
+static struct uart_ctx* uaw_shell_find(const char* name)
+{
+    struct uart_ctx* ctx;
+
+    SYS_SLIST_FOR_EACH_CONTAINER(&uaw_ctx_list, ctx, shell_node) {
+        if (!name || strcmp(ctx->uart->name, name) == 0) {
+            return ctx;
+        }
+    }
+    return NULL;
+}
+
+static void uaw_shell_print(const struct shell* sh, struct uart_ctx* ctx)
+{
+    struct uaw_stats st;
+
+    (void)uaw_get_stats(ctx, &st);
+
+    shell_print(sh, "%s:", ctx->uart->name);
+    shell_print(sh, "  tx: transfers %u, coalesced nodes %u, irqs saved %u", st.tx_transfers, st.tx_coalesced_nodes, st.tx_irqs_saved);
+    shell_print(sh, "  rx: dropped %u, buffer starved %u", st.rx_dropped, st.rx_buf_starved);
+#if CONFIG_UART_WRAPPER_STATS
+    shell_print(sh, "  bytes: in %u, out %u", st.bytes_in, st.bytes_out);
+    shell_print(sh, "  hwm: tx queue %u, rx ring %u", st.tx_queue_hwm, st.rx_ring_hwm);
+    shell_print(sh, "  tx latency (cycles, log2 buckets):");
+    for (size_t i = 0; i < ARRAY_SIZE(st.tx_latency_hist); i++) {
+        if (st.tx_latency_hist[i]) {
+            shell_print(sh, "    < 2^%u: %u", (unsigned int)i, st.tx_latency_hist[i]);
+        }
+    }
+    shell_print(sh, "  isr events:");
+    for (size_t i = 0; i < ARRAY_SIZE(st.isr_events); i++) {
+        if (st.isr_events[i]) {
+            shell_print(sh, "    [%u]: %u", (unsigned int)i, st.isr_events[i]);
+        }
+    }
+#endif
+}
+
+static int cmd_uaw_stats(const struct shell* sh, size_t argc, char** argv)
+{
+    struct uart_ctx* ctx;
+
+    if (argc > 1) {
+        ctx = uaw_shell_find(argv[1]);
+        if (!ctx) {
+            shell_error(sh, "no UART wrapper context on %s", argv[1]);
+            return -ENOENT;
+        }
+        uaw_shell_print(sh, ctx);
+        return 0;
+    }
+
+    SYS_SLIST_FOR_EACH_CONTAINER(&uaw_ctx_list, ctx, shell_node) {
+        uaw_shell_print(sh, ctx);
+    }
+    return 0;
+}
+
+static int cmd_uaw_reset(const struct shell* sh, size_t argc, char** argv)
+{
+    struct uart_ctx* ctx;
+
+    if (argc > 1) {
+        ctx = uaw_shell_find(argv[1]);
+        if (!ctx) {
+            shell_error(sh, "no UART wrapper context on %s", argv[1]);
+            return -ENOENT;
+        }
+        return uaw_reset_stats(ctx);
+    }
+
+    SYS_SLIST_FOR_EACH_CONTAINER(&uaw_ctx_list, ctx, shell_node) {
+        (void)uaw_reset_stats(ctx);
+    }
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_uaw,
+                               SHELL_CMD_ARG(stats, NULL, "Show UART wrapper statistics [device]", cmd_uaw_stats, 1, 1),
+                               SHELL_CMD_ARG(reset, NULL, "Reset UART wrapper statistics [device]", cmd_uaw_reset, 1, 1),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(uaw, &sub_uaw, "UART wrapper commands", NULL);
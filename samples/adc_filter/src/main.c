@@ -0,0 +1,160 @@
+/**
+ * @file main.c
+ * @brief Checks for the analog wrapper reading filters.
+ *
+ * Feeds the moving average, median and IIR filters known input sequences
+ * and compares every output with the value worked out by hand. Then reads
+ * a battery channel on the ADC emulator through the wrapper and checks that
+ * only analog_read_battery_mv() and analog_filter_battery_mv() advance the
+ * battery filter, not analog_raw_to_battery_mv(). Results are printed as
+ * one JSON object per line.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/adc/adc_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+#include "analog_filter.h"
+#include "analog_wrapper.h"
+
+/** @brief Allowed error of a millivolt value read back from the emulator. */
+#define MV_TOLERANCE 2
+
+static const struct adc_dt_spec batt_spec = ADC_DT_SPEC_GET(DT_PATH(zephyr_user));
+static struct analog_control_t batt_ctx;
+
+static int failures;
+
+static void check(const char* name, bool pass, int rc)
+{
+    printk("{\"event\":\"check\",\"name\":\"%s\",\"pass\":%s,\"rc\":%d}\n", name, pass ? "true" : "false", rc);
+    if (!pass) {
+        failures++;
+    }
+}
+
+/* Run @p in through a fresh filter and compare every output with @p expected */
+static void check_sequence(const char* name, enum analog_filter_type type, uint8_t param, const int32_t* in, const int32_t* expected, size_t n)
+{
+    struct analog_filter f;
+    int rc = analog_filter_init(&f, type, param);
+    bool pass = rc == 0;
+
+    for (size_t i = 0; pass && i < n; i++) {
+        int32_t out = analog_filter_update(&f, in[i]);
+
+        if (out != expected[i]) {
+            printk("{\"event\":\"mismatch\",\"name\":\"%s\",\"index\":%u,\"out\":%d,\"expected\":%d}\n", name, (unsigned int)i, out,
+                   expected[i]);
+            pass = false;
+        }
+    }
+    check(name, pass, rc);
+}
+
+static void check_filters(void)
+{
+    /* Mean of the samples seen so far until the window of 4 is full, then of the last 4 */
+    static const int32_t avg_in[] = {100, 200, 300, 400, 500, -300};
+    static const int32_t avg_out[] = {100, 150, 200, 250, 350, 225};
+
+    check_sequence("moving_avg", ANALOG_FILTER_MOVING_AVG, 4, avg_in, avg_out, ARRAY_SIZE(avg_in));
+
+    /* A single spike never gets through a window of 3; an even count averages the middle pair */
+    static const int32_t med_in[] = {100, 5000, 110, 120, 90};
+    static const int32_t med_out[] = {100, 2550, 110, 120, 110};
+
+    check_sequence("median", ANALOG_FILTER_MEDIAN, 3, med_in, med_out, ARRAY_SIZE(med_in));
+
+    /* Step response with k = 2: the remaining error shrinks by 3/4 per sample */
+    static const int32_t iir_in[] = {0, 1000, 1000, 1000, 1000};
+    static const int32_t iir_out[] = {0, 250, 438, 578, 684};
+
+    check_sequence("iir_step", ANALOG_FILTER_IIR, 2, iir_in, iir_out, ARRAY_SIZE(iir_in));
+
+    static const int32_t none_in[] = {7, -7, 70000};
+
+    check_sequence("none", ANALOG_FILTER_NONE, 0, none_in, none_in, ARRAY_SIZE(none_in));
+
+    struct analog_filter f;
+
+    check("reject_window_0", analog_filter_init(&f, ANALOG_FILTER_MOVING_AVG, 0) == -EINVAL, 0);
+    check("reject_window_max",
+          analog_filter_init(&f, ANALOG_FILTER_MEDIAN, CONFIG_ANALOG_WRAPPER_FILTER_WINDOW + 1) == -EINVAL, 0);
+    check("reject_iir_shift", analog_filter_init(&f, ANALOG_FILTER_IIR, 17) == -EINVAL, 0);
+}
+
+static int set_input_mv(int32_t mv)
+{
+    return adc_emul_const_value_set(batt_spec.dev, batt_spec.channel_id, (uint32_t)mv);
+}
+
+/*
+ * With a moving average over 4 readings, a filter advanced by the two
+ * conversions would hold {1000, 1000, 1000, 2000} at the second read and
+ * report 1250 mV instead of 1500 mV.
+ */
+static void check_battery_path(void)
+{
+    int32_t first = 0;
+    int32_t conv[2] = {0};
+    int32_t second = 0;
+    int32_t fed = 3000;
+    int16_t raw = 0;
+    int rc = analog_set_filter(&batt_ctx, ANALOG_FILTER_MOVING_AVG, 4);
+
+    if (rc == 0) {
+        rc = set_input_mv(1000);
+    }
+    if (rc == 0) {
+        rc = analog_read_battery_mv(&batt_ctx, &first);
+    }
+    check("battery_first", rc == 0 && abs(first - 1000) <= MV_TOLERANCE, rc);
+
+    if (rc == 0) {
+        rc = analog_read_raw(&batt_ctx, &raw);
+    }
+    for (size_t i = 0; rc == 0 && i < ARRAY_SIZE(conv); i++) {
+        rc = analog_raw_to_battery_mv(&batt_ctx, raw, &conv[i]);
+    }
+    check("convert_is_pure", rc == 0 && conv[0] == conv[1] && abs(conv[0] - 1000) <= MV_TOLERANCE, rc);
+
+    if (rc == 0) {
+        rc = set_input_mv(2000);
+    }
+    if (rc == 0) {
+        rc = analog_read_battery_mv(&batt_ctx, &second);
+    }
+    check("battery_filtered", rc == 0 && abs(second - 1500) <= MV_TOLERANCE, rc);
+
+    /* What an analog_read_async() callback does with its converted value */
+    if (rc == 0) {
+        rc = analog_filter_battery_mv(&batt_ctx, &fed);
+    }
+    check("battery_fed", rc == 0 && abs(fed - 2000) <= MV_TOLERANCE, rc);
+
+    printk("{\"event\":\"battery\",\"first\":%d,\"convert\":[%d,%d],\"second\":%d,\"fed\":%d}\n", first, conv[0], conv[1], second, fed);
+}
+
+int main(void)
+{
+    check_filters();
+
+    int rc = analog_init(&batt_ctx, &batt_spec);
+
+    if (rc) {
+        printk("{\"event\":\"error\",\"reason\":\"init\",\"rc\":%d}\n", rc);
+        return rc;
+    }
+
+    check_battery_path();
+
+    printk("{\"event\":\"done\",\"failures\":%d}\n", failures);
+    return 0;
+}
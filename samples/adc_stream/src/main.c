@@ -0,0 +1,129 @@
+/**
+ * @file main.c
+ * @brief Continuous block sampling with analog_stream.
+ *
+ * Streams channel 0 of the ADC emulator at 1 kHz in blocks of 64 samples.
+ * The emulator returns a ramp that advances by one step per sampling, so
+ * every block must continue exactly where the previous one ended: a lost,
+ * repeated or overwritten block breaks the ramp. Per-block results are
+ * printed as one JSON object per line.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/adc/adc_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include "analog_stream.h"
+
+#define STREAM_INTERVAL_US 1000
+#define STREAM_BLOCK       64
+#define STREAM_BLOCKS      32
+
+/** @brief Ramp period in emulator steps, stays below the 3300 mV reference. */
+#define RAMP_STEPS 3000
+
+#define STREAM_STACK_SIZE 1024
+#define STREAM_PRIO       K_PRIO_PREEMPT(2)
+
+static const struct adc_dt_spec adc_chan = ADC_DT_SPEC_GET(DT_PATH(zephyr_user));
+
+K_THREAD_STACK_DEFINE(stream_stack, STREAM_STACK_SIZE);
+
+static struct analog_stream stream;
+static int16_t buf_a[STREAM_BLOCK];
+static int16_t buf_b[STREAM_BLOCK];
+
+static K_SEM_DEFINE(blocks_done, 0, 1);
+static uint32_t ramp_step;
+static int32_t expect_mv = -1;
+static uint32_t block_count;
+static int failures;
+
+/* One ramp step in mV per sampling */
+static int ramp_value(const struct device* dev, unsigned int chan, void* data, uint32_t* result)
+{
+    ARG_UNUSED(dev);
+    ARG_UNUSED(chan);
+    ARG_UNUSED(data);
+
+    *result = ramp_step++ % RAMP_STEPS;
+    return 0;
+}
+
+static void block_cb(struct analog_stream* st, const int16_t* block, size_t samples, void* user_data)
+{
+    int32_t first = block[0];
+    int32_t last = block[samples - 1];
+    int breaks = 0;
+
+    ARG_UNUSED(user_data);
+
+    /* Convert back to the emulator's mV steps; 12 bits at 3300 mV is < 1 mV per LSB */
+    for (size_t i = 0; i < samples; i++) {
+        int32_t mv = block[i];
+
+        (void)adc_raw_to_millivolts_dt(&st->adc_dt, &mv);
+        if (expect_mv >= 0 && (mv < expect_mv - 1 || mv > expect_mv + 1)) {
+            breaks++;
+        }
+        expect_mv = (mv + 1) % RAMP_STEPS;
+    }
+
+    printk("{\"event\":\"block\",\"index\":%u,\"samples\":%zu,\"first\":%d,\"last\":%d,\"breaks\":%d}\n", block_count, samples, first,
+           last, breaks);
+    if (breaks) {
+        failures++;
+    }
+
+    if (++block_count == STREAM_BLOCKS) {
+        k_sem_give(&blocks_done);
+    }
+}
+
+int main(void)
+{
+    struct analog_stream_stats st;
+    int rc;
+
+    rc = adc_emul_value_func_set(adc_chan.dev, adc_chan.channel_id, ramp_value, NULL);
+    if (rc) {
+        printk("{\"event\":\"error\",\"reason\":\"adc_emul_value_func_set\",\"rc\":%d}\n", rc);
+        return rc;
+    }
+
+    rc = analog_stream_init(&stream, &adc_chan, buf_a, buf_b, STREAM_BLOCK, STREAM_INTERVAL_US, block_cb, NULL);
+    if (rc == 0) {
+        rc = analog_stream_start(&stream, stream_stack, K_THREAD_STACK_SIZEOF(stream_stack), STREAM_PRIO);
+    }
+    if (rc) {
+        printk("{\"event\":\"error\",\"reason\":\"analog_stream\",\"rc\":%d}\n", rc);
+        return rc;
+    }
+
+    uint32_t t0 = k_cycle_get_32();
+
+    if (k_sem_take(&blocks_done, K_SECONDS(10))) {
+        failures++;
+    }
+
+    uint32_t cycles = k_cycle_get_32() - t0;
+
+    analog_stream_stop(&stream);
+    analog_stream_get_stats(&stream, &st);
+
+    uint64_t ns = k_cyc_to_ns_floor64(cycles);
+    uint64_t samples = (uint64_t)block_count * STREAM_BLOCK;
+
+    printk("{\"event\":\"summary\",\"blocks\":%u,\"errors\":%u,\"samples_per_s\":%llu,\"gap_us_max\":%u}\n", st.blocks, st.errors,
+           ns ? samples * NSEC_PER_SEC / ns : 0, k_cyc_to_us_floor32(st.gap_cycles_max));
+    if (st.errors) {
+        failures++;
+    }
+
+    printk("{\"event\":\"done\",\"failures\":%d}\n", failures);
+    return 0;
+}
@@ -18,6 +18,9 @@
 
 LOG_MODULE_REGISTER(app, LOG_LEVEL_INF);
 
+/** Loop iterations between two reports of the wrapper counters */
+#define STATS_EVERY 15
+
 /* Build ADC channel spec directly from devicetree */
 static struct adc_dt_spec adc_channel =
 #if HAS_VOLTAGE_DIVIDER
@@ -44,6 +47,39 @@ static void pre_measurement_cb(void* user_handle);
  */
 static void post_measurement_cb(void* user_handle);
 
+#if CONFIG_ANALOG_WRAPPER_ASYNC
+/**
+ * @brief Completion of a background battery read, runs on the system work queue.
+ *
+ * @param ctx     Analog wrapper context.
+ * @param result  0 on success, ADC error code otherwise.
+ * @param raw_val Raw ADC value.
+ */
+static void battery_read_done(struct analog_control_t* ctx, int result, int16_t raw_val)
+{
+    int32_t batt_mv;
+
+    if (result == 0) {
+        result = analog_raw_to_battery_mv(ctx, raw_val, &batt_mv);
+    }
+    if (result == 0) {
+        result = analog_filter_battery_mv(ctx, &batt_mv);
+    }
+
+    if (result) {
+        LOG_ERR("Failed to read battery voltage (%d)", result);
+    }
+    else {
+        LOG_INF("Battery: %d mV (%d%%)", batt_mv, analog_battery_level_from_mv(batt_mv, 1100, 3300));
+    }
+
+#if CONFIG_ADC_CONFIGURABLE_INPUTS
+    /* Input pin stays disconnected until the next read reconnects it */
+    analog_disconnect_input(ctx);
+#endif
+}
+#endif
+
 /**
  * @brief Main entry point for battery measurement sample.
  *
@@ -56,8 +92,10 @@ int main(void)
     LOG_INF("Starting Battery measurement sample");
 
     int ret;
+#if !CONFIG_ANALOG_WRAPPER_ASYNC
     int32_t batt_mv;
     int batt_pct;
+#endif
 
 #if !HAS_VOLTAGE_DIVIDER
     LOG_INF("No voltage divider configured, make sure the input voltage is within the ADC range!");
@@ -79,16 +117,43 @@ int main(void)
     };
     analog_register_callbacks(&adc_ctx, &cbs, NULL);
 
-    while (1) {
+#if CONFIG_ANALOG_WRAPPER_FILTER
+    /* Median of the last 5 readings drops single spikes from load steps */
+    analog_set_filter(&adc_ctx, ANALOG_FILTER_MEDIAN, 5);
+#endif
+
+    for (uint32_t loop = 1;; loop++) {
+#if CONFIG_ANALOG_WRAPPER_ASYNC
+        /* The conversion runs in the background, this thread is free meanwhile */
+        ret = analog_read_async(&adc_ctx, battery_read_done);
+        if (ret) {
+            LOG_ERR("Failed to start battery read (%d)", ret);
+        }
+#else
         ret = analog_read_battery_mv(&adc_ctx, &batt_mv);
         if (ret) {
             LOG_ERR("Failed to read battery voltage (%d)", ret);
         }
         else {
-            batt_pct = analog_get_battery_level(&adc_ctx, 1100, 3300);
+            /* Same reading, a second read would feed the filter twice */
+            batt_pct = analog_battery_level_from_mv(batt_mv, 1100, 3300);
             LOG_INF("Battery: %d mV (%d%%)", batt_mv, batt_pct);
         }
 
+#if CONFIG_ADC_CONFIGURABLE_INPUTS
+        /* Input pin stays disconnected while sleeping, the next read reconnects it */
+        analog_disconnect_input(&adc_ctx);
+#endif
+#endif
+
+        if (loop % STATS_EVERY == 0) {
+            struct analog_stats st;
+
+            /* Reconnecting the input costs a channel setup, but calibration follows the policy only */
+            analog_get_stats(&adc_ctx, &st);
+            LOG_INF("ADC: %u reads, %u reconfigs, %u calibrations", st.reads, st.reconfigs, st.calibrations);
+        }
+
         k_sleep(K_SECONDS(2));
     }
 
@@ -0,0 +1,420 @@
+/**
+ * @file main.c
+ * @brief Functional checks and benchmark for the I2C wrapper.
+ *
+ * Runs i2c_wrapper against the MAX31341 and RT9123 emulators on the
+ * emulated I2C controller. The checks cover the blocking and queued paths,
+ * two back-to-back i2cw_async_write_read() calls, retries after injected
+ * bus errors, i2cw_deinit() with transactions still queued and the periodic
+ * sampler, including overrun counting against a slow target. The
+ * benchmark then compares raw i2c_write_read_dt(), the blocking wrapper
+ * call and pipelined i2cw_submit(). Every result is printed as one JSON
+ * object per line.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+#include "emul/max31341_emul.h"
+#include "emul/rt9123_emul.h"
+#include "i2c_sampler.h"
+#include "i2c_wrapper.h"
+
+#define BENCH_RTC_NODE DT_NODELABEL(bench_rtc)
+#define BENCH_AMP_NODE DT_NODELABEL(bench_amp)
+
+/** @brief Transactions per benchmark point. */
+#define BENCH_TXNS 2000
+/** @brief Give up on a point or check if no completion arrives for this long. */
+#define BENCH_STALL_MS 2000
+/** @brief Emulated wire time per transfer, see README. */
+#define BENCH_WIRE_US 20
+
+#define RTC_REG_SECONDS 0x06
+#define RTC_REG_REV_ID  0x59
+#define RTC_REV_ID      0x01
+#define AMP_REG_VOLUME  0x05
+
+/** @brief Sampler period and run length per phase. */
+#define SAMPLER_PERIOD_MS 10
+#define SAMPLER_RUN_MS    200
+/** @brief Emulated wire time that makes every sample outlast three periods. */
+#define SAMPLER_SLOW_US (3 * SAMPLER_PERIOD_MS * USEC_PER_MSEC)
+
+#if CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+    #define COMPLETION_NAME "thread"
+#elif CONFIG_I2C_WRAPPER_COMPLETION_WORKQ
+    #define COMPLETION_NAME "workq"
+#else
+    #define COMPLETION_NAME "direct"
+#endif
+
+#define WORKER_STACK_SIZE 1024
+#define WORKER_PRIO       K_PRIO_PREEMPT(5)
+
+static const struct i2c_dt_spec rtc_spec = I2C_DT_SPEC_GET(BENCH_RTC_NODE);
+static const struct i2c_dt_spec amp_spec = I2C_DT_SPEC_GET(BENCH_AMP_NODE);
+static const struct emul* const rtc_emul = EMUL_DT_GET(BENCH_RTC_NODE);
+static const struct emul* const amp_emul = EMUL_DT_GET(BENCH_AMP_NODE);
+
+#if CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+K_THREAD_STACK_DEFINE(rtc_stack, WORKER_STACK_SIZE);
+K_THREAD_STACK_DEFINE(amp_stack, WORKER_STACK_SIZE);
+#endif
+
+static struct i2c_ctx rtc_ctx;
+static struct i2c_ctx amp_ctx;
+
+static struct k_sem done_sem; /**< Given once per completed transaction */
+static atomic_t done_count;
+static atomic_t done_errors;
+static int last_result;
+static uint8_t last_byte;
+
+static int failures;
+
+static int ctx_init(struct i2c_ctx* ctx, const struct i2c_dt_spec* spec, bool rtc)
+{
+#if CONFIG_I2C_WRAPPER_COMPLETION_THREAD
+    return i2cw_init(ctx, spec, rtc ? rtc_stack : amp_stack, WORKER_STACK_SIZE, WORKER_PRIO);
+#else
+    ARG_UNUSED(rtc);
+    return i2cw_init(ctx, spec, NULL, 0, 0);
+#endif
+}
+
+static void done_cb(void* user_data, int result, uint8_t* buf, size_t len)
+{
+    ARG_UNUSED(user_data);
+
+    last_result = result;
+    last_byte = (buf && len) ? buf[0] : 0;
+    if (result) {
+        atomic_inc(&done_errors);
+    }
+    atomic_inc(&done_count);
+    k_sem_give(&done_sem);
+}
+
+static void check(const char* name, bool pass, int rc)
+{
+    printk("{\"event\":\"check\",\"completion\":\"" COMPLETION_NAME "\",\"name\":\"%s\",\"pass\":%s,\"rc\":%d}\n", name,
+           pass ? "true" : "false", rc);
+    if (!pass) {
+        failures++;
+    }
+}
+
+static void check_blocking(void)
+{
+    uint8_t reg = RTC_REG_REV_ID;
+    uint8_t id = 0;
+    int rc = i2cw_write_read(&rtc_ctx, &reg, 1, &id, 1);
+
+    check("blocking_write_read", rc == 0 && id == RTC_REV_ID, rc);
+
+    const uint8_t tx[3] = {0x12, 0x34, 0x56};
+    uint8_t rx[3] = {0};
+
+    rc = i2cw_burst_write(&rtc_ctx, RTC_REG_SECONDS, tx, sizeof(tx));
+    if (rc == 0) {
+        rc = i2cw_burst_read(&rtc_ctx, RTC_REG_SECONDS, rx, sizeof(rx));
+    }
+    check("burst_round_trip", rc == 0 && memcmp(tx, rx, sizeof(tx)) == 0, rc);
+}
+
+static void check_double_async(void)
+{
+    static const uint8_t reg_id = RTC_REG_REV_ID;
+    static const uint8_t reg_sec = RTC_REG_SECONDS;
+    static uint8_t rx_id;
+    static uint8_t rx_sec;
+    int rc;
+
+    (void)max31341_emul_set_reg(rtc_emul, RTC_REG_SECONDS, 0x42);
+    k_sem_reset(&done_sem);
+    atomic_clear(&done_errors);
+    rx_id = 0;
+    rx_sec = 0;
+
+    /* The second call used to fail or overwrite the first while it was on the bus */
+    rc = i2cw_async_write_read(&rtc_ctx, &reg_id, 1, &rx_id, 1);
+    if (rc == 0) {
+        rc = i2cw_async_write_read(&rtc_ctx, &reg_sec, 1, &rx_sec, 1);
+    }
+    for (int i = 0; rc == 0 && i < 2; i++) {
+        if (k_sem_take(&done_sem, K_MSEC(BENCH_STALL_MS))) {
+            rc = -ETIMEDOUT;
+        }
+    }
+
+    check("double_async_write_read", rc == 0 && atomic_get(&done_errors) == 0 && rx_id == RTC_REV_ID && rx_sec == 0x42, rc);
+}
+
+static void check_retries(void)
+{
+    struct i2cw_stats st;
+    uint8_t reg = RTC_REG_REV_ID;
+    uint8_t id = 0;
+    int rc;
+
+    /* One failure is absorbed by a retry */
+    i2cw_reset_stats(&rtc_ctx);
+    max31341_emul_inject_error(rtc_emul, -EIO, 1);
+    rc = i2cw_write_read(&rtc_ctx, &reg, 1, &id, 1);
+    i2cw_get_stats(&rtc_ctx, &st);
+    check("blocking_retry", rc == 0 && id == RTC_REV_ID && st.retries == 1 && st.gave_up == 0, rc);
+
+    /* One more failure than retries is reported */
+    i2cw_reset_stats(&rtc_ctx);
+    max31341_emul_inject_error(rtc_emul, -EIO, CONFIG_I2C_WRAPPER_RETRIES + 1);
+    rc = i2cw_write_read(&rtc_ctx, &reg, 1, &id, 1);
+    i2cw_get_stats(&rtc_ctx, &st);
+    check("blocking_give_up", rc == -EIO && st.gave_up == 1, rc);
+
+    /* Queued transactions retry the same way */
+    struct i2c_msg msgs[2] = {
+        {.buf = &reg, .len = 1, .flags = I2C_MSG_WRITE},
+        {.buf = &id, .len = 1, .flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP},
+    };
+
+    k_sem_reset(&done_sem);
+    id = 0;
+    max31341_emul_inject_error(rtc_emul, -EIO, 1);
+    rc = i2cw_submit(&rtc_ctx, rtc_spec.addr, msgs, ARRAY_SIZE(msgs), done_cb, NULL);
+    if (rc == 0 && k_sem_take(&done_sem, K_MSEC(BENCH_STALL_MS))) {
+        rc = -ETIMEDOUT;
+    }
+    check("async_retry", rc == 0 && last_result == 0 && last_byte == RTC_REV_ID, rc);
+    max31341_emul_inject_error(rtc_emul, 0, 0);
+}
+
+static void check_deinit_in_flight(void)
+{
+    static const uint8_t reg = RTC_REG_REV_ID;
+    static uint8_t rx[CONFIG_I2C_WRAPPER_QUEUE_DEPTH];
+    int rc = 0;
+
+    atomic_clear(&done_count);
+    i2cw_register_callback(&rtc_ctx, done_cb, NULL);
+    for (int i = 0; rc == 0 && i < CONFIG_I2C_WRAPPER_QUEUE_DEPTH; i++) {
+        rc = i2cw_async_write_read(&rtc_ctx, &reg, 1, &rx[i], 1);
+    }
+
+    /* The worker runs below main's priority, so most of the queue is still pending */
+    int drc = i2cw_deinit(&rtc_ctx);
+    atomic_val_t seen = atomic_get(&done_count);
+
+    k_msleep(20);
+    check("deinit_in_flight", rc == 0 && drc == 0 && atomic_get(&done_count) == seen, drc ? drc : rc);
+
+    /* The context must be reusable afterwards */
+    uint8_t id = 0;
+
+    rc = ctx_init(&rtc_ctx, &rtc_spec, true);
+    if (rc == 0) {
+        rc = i2cw_write_read(&rtc_ctx, &reg, 1, &id, 1);
+    }
+    check("reinit", rc == 0 && id == RTC_REV_ID, rc);
+}
+
+static struct i2cw_sampler sampler;
+static atomic_t sample_errors;
+
+static void sample_cb(void* user_data, int result, uint8_t* buf, size_t len)
+{
+    ARG_UNUSED(user_data);
+    ARG_UNUSED(buf);
+    ARG_UNUSED(len);
+
+    if (result) {
+        atomic_inc(&sample_errors);
+    }
+}
+
+/* Run the timeline for one phase and wait for the last read to complete */
+static void sampler_run(const struct i2cw_sample_slot* slot, uint32_t* samples, uint32_t* overruns)
+{
+    uint32_t s0 = slot->samples;
+    uint32_t o0 = slot->overruns;
+
+    (void)i2cw_sampler_start(&sampler);
+    k_msleep(SAMPLER_RUN_MS);
+    (void)i2cw_sampler_stop(&sampler);
+
+    for (int t = 0; atomic_get(&slot->busy) && t < BENCH_STALL_MS; t++) {
+        k_msleep(1);
+    }
+
+    *samples = slot->samples - s0;
+    *overruns = slot->overruns - o0;
+}
+
+static void check_sampler(void)
+{
+    static uint8_t block[2];
+    const uint32_t expected = SAMPLER_RUN_MS / SAMPLER_PERIOD_MS;
+    uint32_t samples = 0;
+    uint32_t overruns = 0;
+    int rc = i2cw_sampler_init(&sampler, NULL);
+    int idx = -EINVAL;
+
+    atomic_clear(&sample_errors);
+    rt9123_emul_set_delay(amp_emul, 0);
+    if (rc == 0) {
+        idx = i2cw_sampler_add(&sampler, &amp_ctx, amp_spec.addr, AMP_REG_VOLUME, block, sizeof(block), SAMPLER_PERIOD_MS, sample_cb,
+                               NULL);
+        rc = MIN(idx, 0);
+    }
+    if (rc) {
+        check("sampler_on_time", false, rc);
+        check("sampler_overrun", false, rc);
+        return;
+    }
+
+    const struct i2cw_sample_slot* slot = &sampler.slots[idx];
+
+    /* A fast target keeps up: one sample per period, nothing skipped */
+    sampler_run(slot, &samples, &overruns);
+    printk("{\"event\":\"sampler\",\"completion\":\"" COMPLETION_NAME "\",\"phase\":\"fast\",\"samples\":%u,\"overruns\":%u}\n", samples,
+           overruns);
+    check("sampler_on_time", samples >= expected - 2 && samples <= expected + 1 && overruns == 0 && atomic_get(&sample_errors) == 0,
+          rc);
+
+    /* Every read now outlasts three periods, so the skipped periods must be counted */
+    rt9123_emul_set_delay(amp_emul, SAMPLER_SLOW_US);
+    sampler_run(slot, &samples, &overruns);
+    rt9123_emul_set_delay(amp_emul, 0);
+    printk("{\"event\":\"sampler\",\"completion\":\"" COMPLETION_NAME "\",\"phase\":\"slow\",\"samples\":%u,\"overruns\":%u}\n", samples,
+           overruns);
+    check("sampler_overrun", samples > 0 && samples < expected && overruns > 0 && samples + overruns >= expected - 2, rc);
+}
+
+static void bench_report(const char* mode, uint32_t n, uint32_t cycles, int rc)
+{
+    uint64_t ns = k_cyc_to_ns_floor64(cycles);
+    uint64_t centi = n ? ((uint64_t)cycles * 100U) / n : 0;
+
+    printk("{\"event\":\"bench\",\"completion\":\"" COMPLETION_NAME "\",\"mode\":\"%s\",\"txns\":%u,\"ns\":%llu", mode, n, ns);
+    printk(",\"txn_per_s\":%llu", ns ? ((uint64_t)n * NSEC_PER_SEC) / ns : 0);
+    printk(",\"cycles_per_txn\":%llu.%02llu,\"errors\":%ld,\"rc\":%d}\n", centi / 100U, centi % 100U, (long)atomic_get(&done_errors), rc);
+    if (rc) {
+        failures++;
+    }
+}
+
+static void bench_raw(void)
+{
+    uint8_t reg = AMP_REG_VOLUME;
+    uint8_t rx[2];
+    uint32_t n = 0;
+    int rc = 0;
+
+    atomic_clear(&done_errors);
+    uint32_t t0 = k_cycle_get_32();
+
+    for (; rc == 0 && n < BENCH_TXNS; n++) {
+        rc = i2c_write_read_dt(&amp_spec, &reg, 1, rx, sizeof(rx));
+    }
+
+    bench_report("raw", n, k_cycle_get_32() - t0, rc);
+}
+
+static void bench_blocking(void)
+{
+    uint8_t reg = AMP_REG_VOLUME;
+    uint8_t rx[2];
+    uint32_t n = 0;
+    int rc = 0;
+
+    atomic_clear(&done_errors);
+    uint32_t t0 = k_cycle_get_32();
+
+    for (; rc == 0 && n < BENCH_TXNS; n++) {
+        rc = i2cw_write_read(&amp_ctx, &reg, 1, rx, sizeof(rx));
+    }
+
+    bench_report("blocking", n, k_cycle_get_32() - t0, rc);
+}
+
+static void bench_pipelined(void)
+{
+    static uint8_t reg = AMP_REG_VOLUME;
+    static uint8_t rx[2];
+    struct i2c_msg msgs[2] = {
+        {.buf = &reg, .len = 1, .flags = I2C_MSG_WRITE},
+        {.buf = rx, .len = sizeof(rx), .flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP},
+    };
+    uint32_t submitted = 0;
+    uint32_t completed = 0;
+    int rc = 0;
+
+    k_sem_reset(&done_sem);
+    atomic_clear(&done_errors);
+    uint32_t t0 = k_cycle_get_32();
+
+    /* Keep the queue full; a callback frees a slot for the next submit */
+    while (completed < BENCH_TXNS) {
+        while (submitted < BENCH_TXNS) {
+            rc = i2cw_submit(&amp_ctx, amp_spec.addr, msgs, ARRAY_SIZE(msgs), done_cb, NULL);
+            if (rc == -ENOBUFS) {
+                rc = 0;
+                break;
+            }
+            if (rc) {
+                goto out;
+            }
+            submitted++;
+        }
+        if (k_sem_take(&done_sem, K_MSEC(BENCH_STALL_MS))) {
+            rc = -ETIMEDOUT;
+            break;
+        }
+        completed++;
+    }
+
+out:
+    bench_report("pipelined", completed, k_cycle_get_32() - t0, rc);
+}
+
+int main(void)
+{
+    int rc;
+
+    k_sem_init(&done_sem, 0, K_SEM_MAX_LIMIT);
+
+    rc = ctx_init(&rtc_ctx, &rtc_spec, true);
+    if (rc == 0) {
+        rc = ctx_init(&amp_ctx, &amp_spec, false);
+    }
+    if (rc) {
+        printk("{\"event\":\"error\",\"reason\":\"i2cw_init\",\"rc\":%d}\n", rc);
+        return rc;
+    }
+    i2cw_register_callback(&rtc_ctx, done_cb, NULL);
+
+    printk("{\"event\":\"start\",\"completion\":\"" COMPLETION_NAME "\",\"clock_hz\":%u,\"queue_depth\":%u,\"wire_us\":%u}\n",
+           sys_clock_hw_cycles_per_sec(), CONFIG_I2C_WRAPPER_QUEUE_DEPTH, BENCH_WIRE_US);
+
+    check_blocking();
+    check_double_async();
+    check_retries();
+    check_deinit_in_flight();
+    check_sampler();
+
+    (void)rt9123_emul_set_reg(amp_emul, AMP_REG_VOLUME, 0x1234);
+    rt9123_emul_set_delay(amp_emul, BENCH_WIRE_US);
+    bench_raw();
+    bench_blocking();
+    bench_pipelined();
+
+    printk("{\"event\":\"done\",\"failures\":%d}\n", failures);
+    return 0;
+}
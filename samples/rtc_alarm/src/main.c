@@ -0,0 +1,97 @@
+/**
+ * @file main.c
+ * @brief Sleep until the MAX31341 alarm fires.
+ *
+ * Sets the clock, arms alarm 1 a few seconds ahead and blocks on a
+ * semaphore given from the alarm callback. The callback is driven by the
+ * RTC's interrupt line, so the CPU stays idle between wakeups instead of
+ * waking on a timer to poll. On native_sim the RTC is the emulator from
+ * drivers/emul.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/rtc.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(rtc_alarm, LOG_LEVEL_INF);
+
+/** @brief Seconds between wakeups. */
+#define WAKE_INTERVAL_S 2
+/** @brief Wakeups before the sample stops. */
+#define WAKE_COUNT 3
+
+static const struct device* const rtc = DEVICE_DT_GET_ONE(adi_max31341);
+
+static K_SEM_DEFINE(alarm_sem, 0, 1);
+
+static void alarm_cb(const struct device* dev, uint16_t id, void* user_data)
+{
+    ARG_UNUSED(dev);
+    ARG_UNUSED(id);
+    ARG_UNUSED(user_data);
+
+    k_sem_give(&alarm_sem);
+}
+
+/* Arm alarm 1 on the seconds field only, WAKE_INTERVAL_S after now */
+static int arm_alarm(const struct rtc_time* now)
+{
+    struct rtc_time at = {
+        .tm_sec = (now->tm_sec + WAKE_INTERVAL_S) % 60,
+    };
+
+    return rtc_alarm_set_time(rtc, 0, RTC_ALARM_TIME_MASK_SECOND, &at);
+}
+
+int main(void)
+{
+    struct rtc_time now = {
+        .tm_year = 2025 - 1900,
+        .tm_mon = 0,
+        .tm_mday = 1,
+        .tm_wday = 3,
+        .tm_hour = 12,
+    };
+    int ret;
+
+    if (!device_is_ready(rtc)) {
+        LOG_ERR("RTC not ready");
+        return 0;
+    }
+
+    ret = rtc_set_time(rtc, &now);
+    if (ret) {
+        LOG_ERR("Failed to set time (%d)", ret);
+        return 0;
+    }
+
+    ret = rtc_alarm_set_callback(rtc, 0, alarm_cb, NULL);
+    if (ret) {
+        LOG_ERR("Alarm callback not available (%d)", ret);
+        return 0;
+    }
+
+    for (int i = 0; i < WAKE_COUNT; i++) {
+        ret = arm_alarm(&now);
+        if (ret) {
+            LOG_ERR("Failed to arm alarm (%d)", ret);
+            return 0;
+        }
+
+        k_sem_take(&alarm_sem, K_FOREVER);
+
+        ret = rtc_get_time(rtc, &now);
+        if (ret) {
+            LOG_ERR("Failed to get time (%d)", ret);
+            return 0;
+        }
+        LOG_INF("Alarm %d at %04d-%02d-%02d %02d:%02d:%02d", i + 1, now.tm_year + 1900, now.tm_mon + 1, now.tm_mday, now.tm_hour,
+                now.tm_min, now.tm_sec);
+    }
+
+    LOG_INF("Done after %d alarms", WAKE_COUNT);
+    return 0;
+}
@@ -21,15 +21,16 @@ LOG_MODULE_REGISTER(app, LOG_LEVEL_INF);
 /** @brief UART device from devicetree. */
 static const struct device* const uart_dev = DEVICE_DT_GET(UART_NODE);
 
-#if CONFIG_UART_ASYNC_API
-    #define RX_CHUNK 64
-static uint8_t rx_a[RX_CHUNK]; /**< RX buffer A for async API. */
-static uint8_t rx_b[RX_CHUNK]; /**< RX buffer B for async API. */
-#endif
+#define RX_CHUNK 64
+static uint8_t rx_a[RX_CHUNK]; /**< RX buffer A, used by the async API. */
+static uint8_t rx_b[RX_CHUNK]; /**< RX buffer B, used by the async API. */
 
 #define RING_SZ 256
 static uint8_t rx_ring_storage[RING_SZ]; /**< RX ring buffer storage. */
 
+#define TX_POOL_NODES 8
+UAW_TX_POOL_DEFINE(tx_pool, TX_POOL_NODES); /**< TX node pool, keeps writes off the heap. */
+
 static struct uart_ctx uctx; /**< UART wrapper context. */
 
 /**
@@ -60,17 +61,18 @@ int main(void)
 
     int rc;
 
-#if CONFIG_UART_ASYNC_API
     rc = uaw_init(&uctx, uart_dev, rx_a, rx_b, sizeof(rx_a), 100, NULL, tx_done_cb, NULL);
-#else
-    rc = uaw_init(&uctx, uart_dev, NULL, NULL, 0, 0, NULL, tx_done_cb, NULL);
-#endif
 
     if (rc) {
         LOG_ERR("uaw_init rc=%d", rc);
         return rc;
     }
 
+    rc = uaw_tx_pool_set(&uctx, &tx_pool);
+    if (rc) {
+        LOG_ERR("uaw_tx_pool_set rc=%d", rc);
+        return rc;
+    }
     uaw_rx_ring_init(&uctx, rx_ring_storage, sizeof(rx_ring_storage));
 
 #if CONFIG_UART_ASYNC_API
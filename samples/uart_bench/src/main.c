@@ -0,0 +1,295 @@
+/**
+ * @file main.c
+ * @brief Throughput benchmark for the UART wrapper.
+ *
+ * Drives a uart_ctx in loopback over the UART emulator and sweeps message
+ * size, queue depth and TX node allocator. Every measurement point is
+ * printed as one JSON object per line so runs can be collected and compared
+ * across releases. A final soak run pushes SOAK_WRITES pooled writes and
+ * checks that none of them touched the heap or lost data.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/util.h>
+
+#include "uart_wrapper.h"
+
+#define BENCH_UART_NODE DT_NODELABEL(bench_uart)
+
+/** @brief Minimum bytes moved per measurement point. */
+#define BENCH_MIN_BYTES (64 * 1024)
+/** @brief Give up on a point if no progress is made for this long. */
+#define BENCH_STALL_MS 2000
+
+#define RX_CHUNK      256
+#define RX_BUF_COUNT  CONFIG_UART_WRAPPER_RX_BUF_COUNT
+#define TX_POOL_NODES 64
+
+/** @brief Writes in the soak run. */
+#define SOAK_WRITES 100000
+/** @brief Soak write size; every SOAK_SPLIT_EVERY-th write spans two pool nodes. */
+#define SOAK_SIZE        16
+#define SOAK_SPLIT_SIZE  (CONFIG_UART_BUFFER_SIZE + SOAK_SIZE)
+#define SOAK_SPLIT_EVERY 16
+#define SOAK_DEPTH       16
+
+#if CONFIG_UART_ASYNC_API
+    #define BACKEND_NAME "async"
+#else
+    #define BACKEND_NAME "irq"
+#endif
+
+static const struct device* const uart_dev = DEVICE_DT_GET(BENCH_UART_NODE);
+
+static const size_t sizes[] = {1, 4, 16, 64, 256, 1024, 4096};
+static const uint32_t depths[] = {1, 4, 16};
+
+/* Only the async backend hands these to the driver, but uaw_init_bufs()
+ * requires them for both. */
+static uint8_t rx_storage[RX_BUF_COUNT][RX_CHUNK];
+#define BENCH_RX_BUF(i, _) rx_storage[i]
+static uint8_t* const rx_bufs[RX_BUF_COUNT] = {
+    LISTIFY(RX_BUF_COUNT, BENCH_RX_BUF, (, )),
+};
+
+UAW_TX_POOL_DEFINE(tx_pool, TX_POOL_NODES); /**< Pool used by the "pool" points */
+
+static uint8_t tx_pattern[4096];
+static struct uart_ctx uctx;
+
+static struct k_sem window;  /**< One unit per write allowed in flight */
+static struct k_sem rx_done; /**< Given once all expected bytes came back */
+static atomic_t rx_bytes;
+static atomic_t rx_expected;
+static atomic_t tx_done_count; /**< tx_done_cb calls, one per write */
+
+extern struct k_heap _system_heap;
+
+static void rx_cb(struct uart_ctx* ctx, const uint8_t* data, size_t len, void* user)
+{
+    ARG_UNUSED(ctx);
+    ARG_UNUSED(data);
+    ARG_UNUSED(user);
+
+    atomic_val_t got = atomic_add(&rx_bytes, (atomic_val_t)len) + (atomic_val_t)len;
+    if (got >= atomic_get(&rx_expected)) {
+        k_sem_give(&rx_done);
+    }
+}
+
+static void tx_done_cb(struct uart_ctx* ctx, void* user)
+{
+    ARG_UNUSED(ctx);
+    ARG_UNUSED(user);
+    atomic_inc(&tx_done_count);
+    k_sem_give(&window);
+}
+
+/** @brief Print @p num / @p den with two decimals, without float printf support. */
+static void print_ratio(const char* key, uint64_t num, uint64_t den)
+{
+    uint64_t centi = den ? (num * 100U) / den : 0;
+
+    printk(",\"%s\":%llu.%02llu", key, centi / 100U, centi % 100U);
+}
+
+static int bench_point(size_t size, uint32_t depth, bool pool)
+{
+    struct uaw_stats st;
+    struct sys_memory_stats heap;
+    size_t total = ROUND_UP(BENCH_MIN_BYTES, size);
+    size_t sent = 0;
+    int rc = 0;
+
+    rc = uaw_tx_pool_set(&uctx, pool ? &tx_pool : NULL);
+    if (rc) {
+        /* A stalled earlier point can leave TX busy */
+        printk("{\"event\":\"error\",\"reason\":\"uaw_tx_pool_set\",\"size\":%zu,\"depth\":%u,\"rc\":%d}\n", size, depth, rc);
+        return rc;
+    }
+    uaw_reset_stats(&uctx);
+    (void)sys_heap_runtime_stats_reset_max(&_system_heap.heap);
+
+    k_sem_init(&window, depth, depth);
+    k_sem_reset(&rx_done);
+    atomic_set(&rx_bytes, 0);
+    atomic_set(&rx_expected, (atomic_val_t)total);
+
+    uint32_t t0 = k_cycle_get_32();
+
+    while (sent < total) {
+        if (k_sem_take(&window, K_MSEC(BENCH_STALL_MS))) {
+            rc = -ETIMEDOUT;
+            break;
+        }
+
+        rc = uaw_write(&uctx, tx_pattern, size);
+        while (rc == -ENOMEM || rc == -EAGAIN) {
+            /* Pool or heap exhausted: wait for completions to return nodes */
+            k_sleep(K_TICKS(1));
+            rc = uaw_write(&uctx, tx_pattern, size);
+        }
+        if (rc) {
+            break;
+        }
+        sent += size;
+    }
+
+    if (rc == 0 && k_sem_take(&rx_done, K_MSEC(BENCH_STALL_MS))) {
+        rc = -ETIMEDOUT;
+    }
+
+    uint32_t cycles = k_cycle_get_32() - t0;
+
+    uaw_get_stats(&uctx, &st);
+    sys_heap_runtime_stats_get(&_system_heap.heap, &heap);
+
+    uint64_t ns = k_cyc_to_ns_floor64(cycles);
+    size_t moved = (size_t)atomic_get(&rx_bytes);
+
+    printk("{\"event\":\"point\",\"backend\":\"" BACKEND_NAME "\",\"alloc\":\"%s\",\"size\":%zu,\"depth\":%u,\"bytes\":%zu,\"ns\":%llu",
+           pool ? "pool" : "heap", size, depth, moved, ns);
+    printk(",\"bytes_per_s\":%llu", ns ? ((uint64_t)moved * NSEC_PER_SEC) / ns : 0);
+    print_ratio("cycles_per_byte", cycles, moved);
+#if CONFIG_UART_WRAPPER_STATS
+    uint32_t isr = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(st.isr_events); i++) {
+        isr += st.isr_events[i];
+    }
+    print_ratio("isr_per_kib", (uint64_t)isr * 1024U, moved);
+#endif
+    printk(",\"tx_transfers\":%u,\"rx_dropped\":%u,\"heap_hwm\":%zu,\"rc\":%d}\n", st.tx_transfers, st.rx_dropped,
+           heap.max_allocated_bytes, rc);
+
+    if (rc) {
+        uaw_tx_cancel_and_flush(&uctx);
+    }
+    return rc;
+}
+
+/**
+ * @brief Pooled soak run.
+ *
+ * Passes if the heap high-water mark did not move, every byte came back,
+ * no RX data or buffer request was dropped and tx_done_cb ran exactly once
+ * per write, including the writes split across two pool nodes.
+ */
+static int soak(void)
+{
+    struct uaw_stats st;
+    struct sys_memory_stats heap;
+    size_t total = 0;
+    int rc = uaw_tx_pool_set(&uctx, &tx_pool);
+
+    for (uint32_t i = 0; i < SOAK_WRITES; i++) {
+        total += (i % SOAK_SPLIT_EVERY) ? SOAK_SIZE : SOAK_SPLIT_SIZE;
+    }
+
+    uaw_reset_stats(&uctx);
+    sys_heap_runtime_stats_get(&_system_heap.heap, &heap);
+    size_t heap_base = heap.allocated_bytes;
+    (void)sys_heap_runtime_stats_reset_max(&_system_heap.heap);
+
+    k_sem_init(&window, SOAK_DEPTH, SOAK_DEPTH);
+    k_sem_reset(&rx_done);
+    atomic_set(&rx_bytes, 0);
+    atomic_set(&rx_expected, (atomic_val_t)total);
+    atomic_set(&tx_done_count, 0);
+
+    uint32_t writes = 0;
+
+    while (rc == 0 && writes < SOAK_WRITES) {
+        size_t size = (writes % SOAK_SPLIT_EVERY) ? SOAK_SIZE : SOAK_SPLIT_SIZE;
+
+        if (k_sem_take(&window, K_MSEC(BENCH_STALL_MS))) {
+            rc = -ETIMEDOUT;
+            break;
+        }
+        rc = uaw_write(&uctx, tx_pattern, size);
+        while (rc == -ENOMEM || rc == -EAGAIN) {
+            k_sleep(K_TICKS(1));
+            rc = uaw_write(&uctx, tx_pattern, size);
+        }
+        if (rc == 0) {
+            writes++;
+        }
+    }
+
+    if (rc == 0 && k_sem_take(&rx_done, K_MSEC(BENCH_STALL_MS))) {
+        rc = -ETIMEDOUT;
+    }
+    /* The last tx_done_cb may trail the loopback RX */
+    for (int i = 0; rc == 0 && atomic_get(&tx_done_count) < (atomic_val_t)writes && i < BENCH_STALL_MS; i++) {
+        k_msleep(1);
+    }
+
+    uaw_get_stats(&uctx, &st);
+    sys_heap_runtime_stats_get(&_system_heap.heap, &heap);
+
+    size_t heap_growth = heap.max_allocated_bytes - heap_base;
+    size_t moved = (size_t)atomic_get(&rx_bytes);
+    uint32_t done = (uint32_t)atomic_get(&tx_done_count);
+    bool pass = rc == 0 && heap_growth == 0 && moved == total && st.rx_dropped == 0 && st.rx_buf_starved == 0 && done == writes;
+
+    printk("{\"event\":\"soak\",\"backend\":\"" BACKEND_NAME "\",\"writes\":%u,\"tx_done\":%u,\"bytes\":%zu,\"expected\":%zu", writes, done,
+           moved, total);
+    printk(",\"heap_growth\":%zu,\"rx_dropped\":%u,\"rx_buf_starved\":%u,\"pass\":%s,\"rc\":%d}\n", heap_growth, st.rx_dropped,
+           st.rx_buf_starved, pass ? "true" : "false", rc);
+
+    if (rc) {
+        uaw_tx_cancel_and_flush(&uctx);
+    }
+    return pass ? 0 : (rc ? rc : -EIO);
+}
+
+int main(void)
+{
+    int rc;
+    int failures = 0;
+
+    if (!device_is_ready(uart_dev)) {
+        printk("{\"event\":\"error\",\"reason\":\"uart not ready\"}\n");
+        return -ENODEV;
+    }
+
+    for (size_t i = 0; i < sizeof(tx_pattern); i++) {
+        tx_pattern[i] = (uint8_t)i;
+    }
+    k_sem_init(&rx_done, 0, 1);
+
+    rc = uaw_init_bufs(&uctx, uart_dev, rx_bufs, RX_BUF_COUNT, RX_CHUNK, 100, rx_cb, tx_done_cb, NULL);
+    if (rc) {
+        printk("{\"event\":\"error\",\"reason\":\"uaw_init\",\"rc\":%d}\n", rc);
+        return rc;
+    }
+
+#if CONFIG_UART_ASYNC_API
+    uaw_rx_enable(&uctx);
+#endif
+
+    printk("{\"event\":\"start\",\"backend\":\"" BACKEND_NAME "\",\"stats\":%s,\"clock_hz\":%u,\"node_payload\":%u}\n",
+           IS_ENABLED(CONFIG_UART_WRAPPER_STATS) ? "true" : "false", sys_clock_hw_cycles_per_sec(), CONFIG_UART_BUFFER_SIZE);
+
+    for (int pool = 0; pool <= 1; pool++) {
+        for (size_t s = 0; s < ARRAY_SIZE(sizes); s++) {
+            for (size_t d = 0; d < ARRAY_SIZE(depths); d++) {
+                if (bench_point(sizes[s], depths[d], pool)) {
+                    failures++;
+                }
+            }
+        }
+    }
+
+    if (soak()) {
+        failures++;
+    }
+
+    printk("{\"event\":\"done\",\"failures\":%d}\n", failures);
+    return 0;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file main.c
+ * @brief Two-port checks for the UART manager.
+ *
+ * Puts two loopback UART emulators behind one uaw_mgr and checks that a
+ * port with a large backlog cannot starve the other one (fairness) and that
+ * the port with the better priority is served first in a round (priority).
+ * Results are printed as one JSON object per line.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+#include "uart_manager.h"
+#include "uart_wrapper.h"
+
+#define RX_CHUNK   64
+#define WRITE_SIZE 64
+#define QUANTUM    128 /**< Bytes per port per scheduler round */
+#define INFLIGHT   256 /**< Bytes per port in its context queue */
+#define STALL_MS   2000
+
+#define FAIR_BULK_BYTES  (8 * 1024)
+#define FAIR_SMALL_BYTES 1024
+#define PRIO_BYTES       1024
+
+/* The scheduler runs below main, so every write is queued before the first round */
+#define MGR_STACK_SIZE 1024
+#define MGR_PRIO       K_PRIO_PREEMPT(5)
+
+static const struct device* const uart_devs[] = {
+    DEVICE_DT_GET(DT_NODELABEL(mgr_uart0)),
+    DEVICE_DT_GET(DT_NODELABEL(mgr_uart1)),
+};
+
+#define NUM_PORTS ARRAY_SIZE(uart_devs)
+
+BUILD_ASSERT(NUM_PORTS <= CONFIG_UART_WRAPPER_MANAGER_MAX_PORTS, "not enough manager ports");
+
+/**
+ * @brief Receive side of one port.
+ */
+struct port_state
+{
+    uint8_t tag;               /**< Byte value the port sends */
+    atomic_t rx_bytes;         /**< Bytes received back */
+    atomic_val_t expected;     /**< Bytes queued in this run */
+    atomic_t bad;              /**< Received bytes that are not @c tag */
+    int first_rx;              /**< Rank of the first received byte among the ports, -1 before */
+    int done;                  /**< Rank of completion among the ports, -1 before */
+    atomic_val_t other_at_done; /**< Bytes the other port had received at completion */
+    struct k_sem done_sem;
+};
+
+static uint8_t rx_storage[NUM_PORTS][2][RX_CHUNK];
+static uint8_t payload[NUM_PORTS][WRITE_SIZE];
+static struct uart_ctx uctx[NUM_PORTS];
+static struct port_state state[NUM_PORTS];
+static atomic_t first_seq;
+static atomic_t done_seq;
+
+static struct uaw_mgr mgr;
+static struct k_work_q mgr_workq;
+K_THREAD_STACK_DEFINE(mgr_stack, MGR_STACK_SIZE);
+
+static int failures;
+
+static void check(const char* name, bool pass, int rc)
+{
+    printk("{\"event\":\"check\",\"name\":\"%s\",\"pass\":%s,\"rc\":%d}\n", name, pass ? "true" : "false", rc);
+    if (!pass) {
+        failures++;
+    }
+}
+
+static void rx_cb(struct uart_ctx* ctx, const uint8_t* data, size_t len, void* user)
+{
+    struct port_state* ps = user;
+    struct port_state* other = &state[ps == &state[0] ? 1 : 0];
+
+    ARG_UNUSED(ctx);
+
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] != ps->tag) {
+            atomic_inc(&ps->bad);
+        }
+    }
+
+    if (ps->first_rx < 0) {
+        ps->first_rx = (int)atomic_inc(&first_seq);
+    }
+
+    atomic_val_t got = atomic_add(&ps->rx_bytes, (atomic_val_t)len) + (atomic_val_t)len;
+
+    if (ps->done < 0 && got >= ps->expected) {
+        ps->done = (int)atomic_inc(&done_seq);
+        ps->other_at_done = atomic_get(&other->rx_bytes);
+        k_sem_give(&ps->done_sem);
+    }
+}
+
+/** @brief Wait until both ports have drained, then build a fresh manager. */
+static int mgr_setup(const uint8_t prio[NUM_PORTS], const size_t bytes[NUM_PORTS])
+{
+    for (size_t i = 0; i < NUM_PORTS; i++) {
+        for (int t = 0; uaw_tx_queued_bytes(&uctx[i]) && t < STALL_MS; t++) {
+            k_msleep(1);
+        }
+    }
+
+    /* No scheduler round may run while the manager is rebuilt */
+    k_work_queue_drain(&mgr_workq, true);
+
+    int rc = uaw_mgr_init(&mgr, &mgr_workq);
+
+    atomic_set(&first_seq, 0);
+    atomic_set(&done_seq, 0);
+
+    for (size_t i = 0; rc == 0 && i < NUM_PORTS; i++) {
+        struct port_state* ps = &state[i];
+
+        atomic_set(&ps->rx_bytes, 0);
+        atomic_set(&ps->bad, 0);
+        ps->expected = (atomic_val_t)bytes[i];
+        ps->first_rx = -1;
+        ps->done = -1;
+        ps->other_at_done = 0;
+        k_sem_reset(&ps->done_sem);
+
+        int idx = uaw_mgr_add_port(&mgr, &uctx[i], prio[i], QUANTUM, INFLIGHT);
+
+        if (idx != (int)i) {
+            rc = idx < 0 ? idx : -EIO;
+        }
+    }
+
+    k_work_queue_unplug(&mgr_workq);
+    return rc;
+}
+
+static int queue_bytes(int port, size_t bytes)
+{
+    for (size_t sent = 0; sent < bytes; sent += WRITE_SIZE) {
+        int rc = uaw_mgr_write(&mgr, port, payload[port], WRITE_SIZE);
+
+        if (rc) {
+            return rc;
+        }
+    }
+    return 0;
+}
+
+static int wait_done(void)
+{
+    for (size_t i = 0; i < NUM_PORTS; i++) {
+        if (k_sem_take(&state[i].done_sem, K_MSEC(STALL_MS))) {
+            return -ETIMEDOUT;
+        }
+    }
+    return 0;
+}
+
+static bool ports_clean(void)
+{
+    for (size_t i = 0; i < NUM_PORTS; i++) {
+        if (atomic_get(&state[i].bad) || mgr.ports[i].pending_bytes) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Port 0 queues a large backlog first, port 1 a small one after it, both at
+ * the same priority. Port 1 must finish first, and port 0 may only have run
+ * about as far as port 1 by then.
+ */
+static void check_fairness(void)
+{
+    const uint8_t prio[NUM_PORTS] = {0, 0};
+    const size_t bytes[NUM_PORTS] = {FAIR_BULK_BYTES, FAIR_SMALL_BYTES};
+    int rc = mgr_setup(prio, bytes);
+
+    if (rc == 0) {
+        rc = queue_bytes(0, bytes[0]);
+    }
+    if (rc == 0) {
+        rc = queue_bytes(1, bytes[1]);
+    }
+    if (rc == 0) {
+        rc = wait_done();
+    }
+
+    printk("{\"event\":\"fairness\",\"bulk_done\":%d,\"small_done\":%d,\"bulk_bytes_at_small_done\":%ld}\n", state[0].done, state[1].done,
+           (long)state[1].other_at_done);
+
+    check("fairness_small_first", rc == 0 && state[1].done < state[0].done, rc);
+    check("fairness_bulk_bounded", rc == 0 && state[1].other_at_done <= 2 * (FAIR_SMALL_BYTES + INFLIGHT), rc);
+    check("fairness_data", rc == 0 && ports_clean(), rc);
+}
+
+/*
+ * Port 1 is added second but with the better priority. It must be first in
+ * the scheduler order and the first port to get data back.
+ */
+static void check_priority(void)
+{
+    const uint8_t prio[NUM_PORTS] = {1, 0};
+    const size_t bytes[NUM_PORTS] = {PRIO_BYTES, PRIO_BYTES};
+    int rc = mgr_setup(prio, bytes);
+
+    if (rc == 0) {
+        rc = queue_bytes(0, bytes[0]);
+    }
+    if (rc == 0) {
+        rc = queue_bytes(1, bytes[1]);
+    }
+    if (rc == 0) {
+        rc = wait_done();
+    }
+
+    printk("{\"event\":\"priority\",\"order\":[%u,%u],\"first_rx\":[%d,%d]}\n", mgr.order[0], mgr.order[1], state[0].first_rx,
+           state[1].first_rx);
+
+    check("priority_order", rc == 0 && mgr.order[0] == 1, rc);
+    check("priority_served_first", rc == 0 && state[1].first_rx == 0, rc);
+    check("priority_data", rc == 0 && ports_clean(), rc);
+}
+
+int main(void)
+{
+    int rc = 0;
+
+    k_work_queue_init(&mgr_workq);
+    k_work_queue_start(&mgr_workq, mgr_stack, K_THREAD_STACK_SIZEOF(mgr_stack), MGR_PRIO, NULL);
+
+    for (size_t i = 0; rc == 0 && i < NUM_PORTS; i++) {
+        uint8_t* const rx_bufs[] = {rx_storage[i][0], rx_storage[i][1]};
+
+        state[i].tag = (uint8_t)('A' + i);
+        memset(payload[i], state[i].tag, sizeof(payload[i]));
+        k_sem_init(&state[i].done_sem, 0, 1);
+
+        rc = uaw_init_bufs(&uctx[i], uart_devs[i], rx_bufs, ARRAY_SIZE(rx_bufs), RX_CHUNK, 100, rx_cb, NULL, &state[i]);
+        if (rc == 0) {
+            rc = uaw_rx_enable(&uctx[i]);
+        }
+    }
+    if (rc) {
+        printk("{\"event\":\"error\",\"reason\":\"init\",\"rc\":%d}\n", rc);
+        return rc;
+    }
+
+    check_fairness();
+    check_priority();
+
+    printk("{\"event\":\"done\",\"failures\":%d}\n", failures);
+    return 0;
+}
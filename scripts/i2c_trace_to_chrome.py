@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: Apache-2.0
+"""Convert an "i2cw trace dump" shell capture to Chrome trace-event JSON.
+
+Usage:
+    i2c_trace_to_chrome.py capture.log > trace.json
+
+Open the result in chrome://tracing or https://ui.perfetto.dev. Every
+transfer attempt becomes a "bus" slice on the track of its target address,
+preceded by a "queued" slice covering the time between submission and the
+start on the bus.
+"""
+
+import argparse
+import json
+import sys
+
+DIRS = {0: "write", 1: "read", 2: "write-read"}
+
+
+def parse(lines):
+    hz = None
+    records = []
+    for line in lines:
+        idx = line.find("I2CTRACE ")
+        if idx < 0:
+            continue
+        fields = line[idx:].split()[1:]
+        if not fields or fields[0] == "end":
+            continue
+        if fields[0].startswith("hz="):
+            hz = int(fields[0][3:])
+            continue
+        seq, addr, direction, length, t_submit, t_start, t_done, result, attempt = fields[:9]
+        records.append({
+            "seq": int(seq),
+            "addr": int(addr, 16),
+            "dir": int(direction),
+            "len": int(length),
+            "t_submit": int(t_submit),
+            "t_start": int(t_start),
+            "t_done": int(t_done),
+            "result": int(result),
+            "attempt": int(attempt),
+        })
+    if hz is None:
+        raise ValueError("no 'I2CTRACE hz=' header found")
+    records.sort(key=lambda r: r["seq"])
+    return hz, records
+
+
+def unwrap(records):
+    """Extend the 32-bit cycle counters to a monotonic 64-bit timeline."""
+    base = None
+    offset = 0
+    last = None
+    for rec in records:
+        for key in ("t_submit", "t_start", "t_done"):
+            raw = rec[key]
+            if base is None:
+                base = raw
+            if last is not None and raw + offset < last - (1 << 31):
+                offset += 1 << 32
+            rec[key] = raw + offset - base
+            last = max(last or 0, raw + offset)
+    return records
+
+
+def to_events(hz, records):
+    us = 1e6 / hz
+    events = []
+    for rec in records:
+        tid = "0x%02x" % rec["addr"]
+        args = {
+            "seq": rec["seq"],
+            "dir": DIRS.get(rec["dir"], rec["dir"]),
+            "len": rec["len"],
+            "result": rec["result"],
+            "attempt": rec["attempt"],
+        }
+        if rec["t_start"] > rec["t_submit"]:
+            events.append({
+                "name": "queued",
+                "cat": "i2c",
+                "ph": "X",
+                "pid": "i2c",
+                "tid": tid,
+                "ts": rec["t_submit"] * us,
+                "dur": (rec["t_start"] - rec["t_submit"]) * us,
+                "args": args,
+            })
+        events.append({
+            "name": "%s %uB%s" % (args["dir"], rec["len"], "" if rec["result"] == 0 else " err %d" % rec["result"]),
+            "cat": "i2c",
+            "ph": "X",
+            "pid": "i2c",
+            "tid": tid,
+            "ts": rec["t_start"] * us,
+            "dur": max(rec["t_done"] - rec["t_start"], 0) * us,
+            "args": args,
+        })
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", nargs="?", help="shell capture, stdin if omitted")
+    args = parser.parse_args()
+
+    src = open(args.capture, encoding="utf-8", errors="replace") if args.capture else sys.stdin
+    with src:
+        hz, records = parse(src)
+
+    json.dump({"traceEvents": to_events(hz, unwrap(records)), "displayTimeUnit": "ns"}, sys.stdout, indent=1)
+    sys.stdout.write("\n")
+
+
+if __name__ == "__main__":
+    main()